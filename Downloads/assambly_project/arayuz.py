@@ -1,8 +1,7 @@
 import PySimpleGUI as sg
-import subprocess
 import os
 import ctypes
-import re 
+import json
 
 # --- Tekrarlanan Mesajlar için Sabitler ---
 MSG_PROGRAM_YUKLENMEDI_BASLIK = "Program Yüklenmedi"
@@ -15,6 +14,25 @@ MSG_MOTOR_YUKLENEMEDI_RESET = MSG_MOTOR_YUKLENEMEDI_ICERIK_KISMI
 MSG_MOTOR_VEYA_PROGRAM_YOK = "Motor yüklenmedi veya program yüklenmedi."
 MSG_ISLEM_HATASI_BASLIK = "İşlem Hatası"
 
+MEMORY_SIZE = 65536
+HISTORY_BUDGET_BYTES = 16 * 1024 * 1024 # Geri adım geçmişi için bellek sınırı
+# run_cpu_dll tek çağrıda en fazla bu kadar komut çalıştırır
+RUN_MAX_STEPS = 1_000_000
+# emulator.hpp'deki StopReason değerleri
+STOP_REASON_TEXT = {
+    0: "Adım sınırına ulaşıldı",
+    1: "SWI ile durdu",
+    2: "Bilinmeyen opcode",
+    3: "Kesme noktası",
+    4: "PC izin verilen aralığın dışında",
+    5: "Çevrim sınırına ulaşıldı",
+    6: "Geçmişin başına gelindi",
+    7: "İzleme noktası",
+    8: "WAI ile kesme bekleniyor",
+}
+# breakpoints.hpp'deki WatchKind değerleri
+WATCH_KIND_TEXT = {0: "Kesme noktası", 1: "Okuma", 2: "Yazma"}
+
 # --- C++ DLL ve Fonksiyon Tanımlamaları ---
 script_dir = os.path.dirname(os.path.abspath(__file__))
 DLL_NAME_BASE = "sim_engine.dll" if os.name == 'nt' else "sim_engine.so"
@@ -27,7 +45,8 @@ class CppCPUState(ctypes.Structure):
         ("ix", ctypes.c_uint16),
         ("accA", ctypes.c_uint8),
         ("accB", ctypes.c_uint8),
-        ("ccr", ctypes.c_uint8) 
+        ("ccr", ctypes.c_uint8),
+        ("cycles", ctypes.c_uint64)
     ]
 
     def get_flag(self, bit_pos):
@@ -46,24 +65,133 @@ class CppCPUState(ctypes.Structure):
     @property
     def C_flag(self): return self.get_flag(0)
 
+# assemble_string_dll çıktısı (engine_wrapper.cpp'deki yapılarla aynı düzen)
+class AsmSegmentInfo(ctypes.Structure):
+    _fields_ = [("offset", ctypes.c_uint32), ("length", ctypes.c_uint32), ("address", ctypes.c_uint16)]
+
+class AsmSymbolInfo(ctypes.Structure):
+    _fields_ = [("name", ctypes.c_char_p), ("address", ctypes.c_int32)]
+
+class AsmDiagnosticInfo(ctypes.Structure):
+    _fields_ = [("line", ctypes.c_int32), ("is_error", ctypes.c_int32), ("message", ctypes.c_char_p), ("column", ctypes.c_int32)]
+
+class AssemblyOutput(ctypes.Structure):
+    _fields_ = [
+        ("code", ctypes.POINTER(ctypes.c_uint8)),
+        ("code_length", ctypes.c_uint32),
+        ("segments", ctypes.POINTER(AsmSegmentInfo)),
+        ("segment_count", ctypes.c_uint32),
+        ("symbols", ctypes.POINTER(AsmSymbolInfo)),
+        ("symbol_count", ctypes.c_uint32),
+        ("diagnostics", ctypes.POINTER(AsmDiagnosticInfo)),
+        ("diagnostic_count", ctypes.c_uint32),
+        ("error_count", ctypes.c_int32),
+        ("org_address", ctypes.c_uint16)
+    ]
+
+# edit_assembly_session_dll çıktısı: son düzenlemenin bellek yamaları
+class SessionEditOutput(ctypes.Structure):
+    _fields_ = [
+        ("bytes", ctypes.POINTER(ctypes.c_uint8)),
+        ("byte_count", ctypes.c_uint32),
+        ("patches", ctypes.POINTER(AsmSegmentInfo)),
+        ("patch_count", ctypes.c_uint32),
+        ("reencoded_lines", ctypes.c_uint32),
+        ("error_count", ctypes.c_int32)
+    ]
+
+# take_watch_hit_dll çıktısı (breakpoints.hpp'deki WatchHit ile aynı düzen)
+class WatchHit(ctypes.Structure):
+    _fields_ = [("address", ctypes.c_uint16), ("pc", ctypes.c_uint16), ("value", ctypes.c_uint8), ("kind", ctypes.c_uint8)]
+
 engine_lib = None
+emulator_handle = None  # create_emulator_dll'den dönen opak tutamaç
 engine_initialized = False
+emulator_memory = None
 
 try:
     engine_lib = ctypes.CDLL(DLL_PATH)
 
-    engine_lib.initialize_engine_dll.restype = None
+    EmulatorHandle = ctypes.c_void_p
+    engine_lib.create_emulator_dll.restype = EmulatorHandle
+    engine_lib.destroy_emulator_dll.argtypes = [EmulatorHandle]
+    engine_lib.destroy_emulator_dll.restype = None
+    engine_lib.reset_cpu_dll.argtypes = [EmulatorHandle]
     engine_lib.reset_cpu_dll.restype = None
-    engine_lib.load_program_dll.argtypes = [ctypes.POINTER(ctypes.c_uint8), ctypes.c_int, ctypes.c_uint16]
+    engine_lib.load_program_dll.argtypes = [EmulatorHandle, ctypes.POINTER(ctypes.c_uint8), ctypes.c_int, ctypes.c_uint16]
     engine_lib.load_program_dll.restype = None
+    engine_lib.step_cpu_dll.argtypes = [EmulatorHandle]
     engine_lib.step_cpu_dll.restype = None
+    engine_lib.run_cpu_dll.argtypes = [EmulatorHandle, ctypes.c_uint32, ctypes.c_uint64, ctypes.c_int, ctypes.c_uint32,
+                                       ctypes.POINTER(ctypes.c_uint16), ctypes.c_int,
+                                       ctypes.c_uint16, ctypes.c_uint16,
+                                       ctypes.POINTER(CppCPUState), ctypes.POINTER(ctypes.c_uint32)]
+    engine_lib.run_cpu_dll.restype = ctypes.c_int
+    engine_lib.get_cpu_state_dll.argtypes = [EmulatorHandle]
     engine_lib.get_cpu_state_dll.restype = CppCPUState
-    engine_lib.read_memory_dll.argtypes = [ctypes.c_uint16]
+    engine_lib.read_memory_dll.argtypes = [EmulatorHandle, ctypes.c_uint16]
     engine_lib.read_memory_dll.restype = ctypes.c_uint8
-    engine_lib.write_memory_dll.argtypes = [ctypes.c_uint16, ctypes.c_uint8]
+    engine_lib.write_memory_dll.argtypes = [EmulatorHandle, ctypes.c_uint16, ctypes.c_uint8]
     engine_lib.write_memory_dll.restype = None
-
-    engine_lib.initialize_engine_dll()
+    engine_lib.read_memory_range_dll.argtypes = [EmulatorHandle, ctypes.c_uint16, ctypes.POINTER(ctypes.c_uint8), ctypes.c_int]
+    engine_lib.read_memory_range_dll.restype = ctypes.c_int
+    engine_lib.write_memory_range_dll.argtypes = [EmulatorHandle, ctypes.c_uint16, ctypes.POINTER(ctypes.c_uint8), ctypes.c_int]
+    engine_lib.write_memory_range_dll.restype = ctypes.c_int
+    engine_lib.get_memory_pointer_dll.argtypes = [EmulatorHandle]
+    engine_lib.get_memory_pointer_dll.restype = ctypes.c_void_p
+    engine_lib.take_dirty_ranges_dll.argtypes = [EmulatorHandle, ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_uint32), ctypes.c_int]
+    engine_lib.take_dirty_ranges_dll.restype = ctypes.c_int
+
+    engine_lib.set_history_dll.argtypes = [EmulatorHandle, ctypes.c_uint64, ctypes.c_int]
+    engine_lib.set_history_dll.restype = None
+    engine_lib.reverse_step_dll.argtypes = [EmulatorHandle, ctypes.POINTER(CppCPUState)]
+    engine_lib.reverse_step_dll.restype = ctypes.c_int
+    engine_lib.set_breakpoint_dll.argtypes = [EmulatorHandle, ctypes.c_int, ctypes.c_uint16, ctypes.c_int, ctypes.c_char_p]
+    engine_lib.set_breakpoint_dll.restype = ctypes.c_int
+    engine_lib.clear_breakpoints_dll.argtypes = [EmulatorHandle]
+    engine_lib.clear_breakpoints_dll.restype = None
+    engine_lib.take_watch_hit_dll.argtypes = [EmulatorHandle, ctypes.POINTER(WatchHit)]
+    engine_lib.take_watch_hit_dll.restype = ctypes.c_int
+    engine_lib.map_memory_dll.argtypes = [EmulatorHandle, ctypes.c_uint16, ctypes.c_int, ctypes.c_int]
+    engine_lib.map_memory_dll.restype = ctypes.c_int
+    engine_lib.attach_device_dll.argtypes = [EmulatorHandle, ctypes.c_int, ctypes.c_uint16]
+    engine_lib.attach_device_dll.restype = ctypes.c_int
+    engine_lib.clear_devices_dll.argtypes = [EmulatorHandle]
+    engine_lib.clear_devices_dll.restype = None
+    engine_lib.uart_take_output_dll.argtypes = [EmulatorHandle, ctypes.c_uint16, ctypes.POINTER(ctypes.c_uint8), ctypes.c_int]
+    engine_lib.uart_take_output_dll.restype = ctypes.c_int
+    engine_lib.uart_feed_input_dll.argtypes = [EmulatorHandle, ctypes.c_uint16, ctypes.c_char_p, ctypes.c_int]
+    engine_lib.uart_feed_input_dll.restype = ctypes.c_int
+    engine_lib.set_irq_dll.argtypes = [EmulatorHandle, ctypes.c_int]
+    engine_lib.set_irq_dll.restype = None
+    engine_lib.trigger_nmi_dll.argtypes = [EmulatorHandle]
+    engine_lib.trigger_nmi_dll.restype = None
+    engine_lib.assemble_string_dll.argtypes = [ctypes.c_char_p, ctypes.POINTER(AssemblyOutput)]
+    engine_lib.assemble_string_dll.restype = ctypes.c_void_p
+    engine_lib.free_assembly_dll.argtypes = [ctypes.c_void_p]
+    engine_lib.free_assembly_dll.restype = None
+    engine_lib.assembly_listing_dll.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    engine_lib.assembly_listing_dll.restype = ctypes.c_char_p
+    engine_lib.load_object_dll.argtypes = [EmulatorHandle, ctypes.c_char_p, ctypes.c_int, ctypes.c_int, ctypes.c_uint16,
+                                           ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_uint32), ctypes.c_int]
+    engine_lib.load_object_dll.restype = ctypes.c_int
+    AssemblySessionHandle = ctypes.c_void_p
+    engine_lib.create_assembly_session_dll.restype = AssemblySessionHandle
+    engine_lib.destroy_assembly_session_dll.argtypes = [AssemblySessionHandle]
+    engine_lib.destroy_assembly_session_dll.restype = None
+    engine_lib.edit_assembly_session_dll.argtypes = [AssemblySessionHandle, ctypes.c_int, ctypes.c_int, ctypes.c_char_p,
+                                                     ctypes.POINTER(SessionEditOutput)]
+    engine_lib.edit_assembly_session_dll.restype = ctypes.c_int
+    engine_lib.apply_session_patches_dll.argtypes = [EmulatorHandle, AssemblySessionHandle]
+    engine_lib.apply_session_patches_dll.restype = ctypes.c_int
+    engine_lib.assembly_session_output_dll.argtypes = [AssemblySessionHandle, ctypes.POINTER(AssemblyOutput)]
+    engine_lib.assembly_session_output_dll.restype = ctypes.c_void_p
+
+    emulator_handle = engine_lib.create_emulator_dll()
+    # Geri adım için her komuttan önce snapshot al (yazma anında kopyalanan sayfalarla)
+    engine_lib.set_history_dll(emulator_handle, HISTORY_BUDGET_BYTES, 1)
+    # Emülatör belleğini kopyalamadan gösteren görünüm; bellek dökümü için DLL çağrısı gerekmez
+    emulator_memory = memoryview((ctypes.c_uint8 * MEMORY_SIZE).from_address(engine_lib.get_memory_pointer_dll(emulator_handle))).cast('B')
     engine_initialized = True
     print("C++ Simülatör Motoru başarıyla yüklendi ve başlatıldı.")
 
@@ -87,6 +215,7 @@ def update_gui_registers(window, current_cpu_state):
     window['-A-'].update(f"{current_cpu_state.accA:02X}")
     window['-B-'].update(f"{current_cpu_state.accB:02X}")
     window['-CCR_BYTE-'].update(f"{current_cpu_state.ccr:02X}")
+    window['-CYCLES-'].update(str(current_cpu_state.cycles))
     
     window['-H-'].update(bool(current_cpu_state.H_flag))
     window['-I-'].update(bool(current_cpu_state.I_flag))
@@ -95,64 +224,193 @@ def update_gui_registers(window, current_cpu_state):
     window['-V-'].update(bool(current_cpu_state.V_flag))
     window['-C-'].update(bool(current_cpu_state.C_flag))
 
-def _find_org_address(lines: list) -> int:
-    org_address = 0 
-    for line in lines:
-        if "ORG" in line.upper() and "->" in line and "(Directive)" in line:
-            try:
-                match = re.search(r'ORG\s+\$(\w+)', line, re.IGNORECASE)
-                if match:
-                    org_address = int(match.group(1), 16)
-                    print(f"Parsed ORG address: ${org_address:04X}")
-                    return org_address 
-            except ValueError:
-                print(f"Uyarı: ORG adresi ayrıştırılamadı (ValueError): {line}")
-            except Exception as e:
-                print(f"Uyarı: ORG adresi ayrıştırılırken genel hata: {e} - Satır: {line}")
-    return org_address
-
-def _parse_machine_code_from_line(line_part: str) -> list[int]:
-    instruction_bytes = []
-    hex_bytes_str_list = line_part.strip().split()
-    
-    for hex_byte_str in hex_bytes_str_list:
-        if hex_byte_str.upper() == "XX":
-            instruction_bytes.append(0xEE) 
+def assembly_output_to_dict(output, result_handle) -> dict:
+    code = bytes(output.code[:output.code_length]) if output.code_length else b""
+    segments = []
+    for i in range(output.segment_count):
+        seg = output.segments[i]
+        segments.append((seg.address, code[seg.offset:seg.offset + seg.length]))
+    symbols = [(output.symbols[i].name.decode('utf-8', 'replace'), output.symbols[i].address)
+               for i in range(output.symbol_count)]
+    diagnostics = [(output.diagnostics[i].line, bool(output.diagnostics[i].is_error),
+                    output.diagnostics[i].message.decode('utf-8', 'replace'), output.diagnostics[i].column)
+                   for i in range(output.diagnostic_count)]
+    # Listeleme satırları (adres, byte'lar, çevrim, kaynak) motorun JSON çıktısından okunur
+    listing = json.loads(engine_lib.assembly_listing_dll(result_handle, 1).decode('utf-8', 'replace'))
+    return {"code": code, "segments": segments, "symbols": symbols, "diagnostics": diagnostics,
+            "error_count": output.error_count, "org_address": output.org_address, "listing": listing["lines"]}
+
+def assemble_source(source_text: str) -> dict:
+    # Kaynak motor içinde derlenir; sonuç DLL tamponlarından Python nesnelerine kopyalanıp hemen bırakılır
+    output = AssemblyOutput()
+    result_handle = engine_lib.assemble_string_dll(source_text.encode('utf-8'), ctypes.byref(output))
+    try:
+        return assembly_output_to_dict(output, result_handle)
+    finally:
+        engine_lib.free_assembly_dll(result_handle)
+
+def session_result(session) -> dict:
+    # Oturumdaki programın tamamı, assemble_source ile aynı biçimde
+    output = AssemblyOutput()
+    result_handle = engine_lib.assembly_session_output_dll(session, ctypes.byref(output))
+    try:
+        return assembly_output_to_dict(output, result_handle)
+    finally:
+        engine_lib.free_assembly_dll(result_handle)
+
+def split_source_lines(source_text: str) -> list:
+    # Motorun satır bölme kuralı: '\n' ile bölünür, sondaki boş parça satır sayılmaz
+    lines = source_text.split('\n')
+    if lines and lines[-1] == "":
+        lines.pop()
+    return lines
+
+def edit_session_source(session, old_lines: list, source_text: str):
+    # Yeni metin önceki satırlarla karşılaştırılır; ortak önek ve sonek dışında kalan satırlar
+    # tek bir düzenleme olarak gönderilir (editörde tek satır değişince tek satır yeniden derlenir)
+    new_lines = split_source_lines(source_text)
+    prefix = 0
+    limit = min(len(old_lines), len(new_lines))
+    while prefix < limit and old_lines[prefix] == new_lines[prefix]:
+        prefix += 1
+    suffix = 0
+    while suffix < limit - prefix and old_lines[-1 - suffix] == new_lines[-1 - suffix]:
+        suffix += 1
+    replaced = new_lines[prefix:len(new_lines) - suffix]
+    text = "".join(line + "\n" for line in replaced)
+    edit_output = SessionEditOutput()
+    engine_lib.edit_assembly_session_dll(session, prefix, len(old_lines) - prefix - suffix,
+                                         text.encode('utf-8'), ctypes.byref(edit_output))
+    return new_lines, edit_output
+
+def format_assembly_report(result: dict) -> str:
+    lines = []
+    for line_no, is_error, message, column in result["diagnostics"]:
+        position = f"Satır {line_no}, Sütun {column}" if column else f"Satır {line_no}"
+        lines.append(f"{'Hata' if is_error else 'Uyarı'} ({position}): {message}")
+    if result["diagnostics"]:
+        lines.append("")
+    for address, data in result["segments"]:
+        lines.append(f"Bölüm ${address:04X} ({len(data)} byte)")
+    if result["listing"]:
+        lines.append("")
+        lines.append("Satır Adres Byte'lar  Çevrim  Kaynak")
+        for entry in result["listing"]:
+            data = " ".join(entry["bytes"][i:i + 2] for i in range(0, len(entry["bytes"]), 2))
+            cycles = str(entry["cycles"]) if entry["cycles"] else ""
+            lines.append(f"{entry['line']:>5} {entry['address'] & 0xFFFF:04X}  {data:<9} {cycles:>6}  {entry['source']}")
+    if result["symbols"]:
+        lines.append("")
+        lines.append("Semboller:")
+        for name, address in result["symbols"]:
+            lines.append(f"  {name:<16} ${address & 0xFFFF:04X}")
+    return "\n".join(lines)
+
+def load_segments(segments):
+    # load_program_dll PC'yi yüklenen adrese kurar; ilk bölüm en son yüklenerek PC oraya bırakılır
+    for address, data in reversed(segments):
+        code_array = (ctypes.c_uint8 * len(data)).from_buffer_copy(data)
+        engine_lib.load_program_dll(emulator_handle, code_array, len(data), address)
+
+def apply_breakpoints(spec: str):
+    """'$0105; w$0200-$020F VAL==$FF; r$0051; $0110 A==5' biçimindeki listeyi motora kurar.
+    Önek yoksa çalıştırma kesme noktası, r/w/rw okuma/yazma izleme noktasıdır; adresten sonra
+    boşlukla ayrılmış isteğe bağlı koşul gelir. (kurulan, hatalar) döndürür."""
+    engine_lib.clear_breakpoints_dll(emulator_handle)
+    installed, errors = 0, []
+    for entry in spec.split(';'):
+        entry = entry.strip()
+        if not entry:
+            continue
+        address_text, _, condition = entry.partition(' ')
+        kinds = [0]
+        lowered = address_text.lower()
+        if lowered.startswith('rw'):
+            kinds, address_text = [1, 2], address_text[2:]
+        elif lowered[:1] in ('r', 'w'):
+            kinds, address_text = ([1] if lowered[0] == 'r' else [2]), address_text[1:]
+        try:
+            first, _, last = address_text.partition('-')
+            start = int(first.strip().lstrip('$'), 16)
+            end = int(last.strip().lstrip('$'), 16) if last else start
+            if not (0 <= start <= end <= 0xFFFF):
+                raise ValueError
+        except ValueError:
+            errors.append(f"'{entry}': geçersiz adres")
+            continue
+        if all(engine_lib.set_breakpoint_dll(emulator_handle, kind, start, end - start + 1, condition.strip().encode('utf-8'))
+               for kind in kinds):
+            installed += 1
         else:
-            try:
-                instruction_bytes.append(int(hex_byte_str, 16))
-            except ValueError:
-                instruction_bytes.append(0xFF) 
-    return instruction_bytes
-
-def parse_assembler_output(output_str: str) -> tuple[list[int], int]:
-    if not isinstance(output_str, str): 
-        print(f"Hata: parse_assembler_output geçersiz girdi tipi aldı: {type(output_str)}")
-        return [], 0
-
-    machine_code_bytes_final = []
-    lines = output_str.strip().split('\n')
-    
-    org_address = _find_org_address(lines)
-    
-    for line_content in lines:
-        if "->" not in line_content or \
-           "(Directive)" in line_content or \
-           "ERROR" in line_content.upper() or \
-           "HATA" in line_content.upper() or \
-           not line_content.strip(): 
+            errors.append(f"'{entry}': geçersiz koşul")
+    return installed, errors
+
+def watch_hit_text():
+    # Son çalıştırmada tetiklenen izleme noktası (yoksa boş)
+    hit = WatchHit()
+    if not engine_lib.take_watch_hit_dll(emulator_handle, ctypes.byref(hit)):
+        return ""
+    return f"{WATCH_KIND_TEXT.get(hit.kind, '?')} ${hit.address:04X} = ${hit.value:02X}"
+
+DEVICE_TYPES = {'uart': 0, 'timer': 1, 'pia': 2} # devices.hpp'deki DeviceType
+uart_bases = []  # Takılı UART'ların taban adresleri (terminal bunlardan okur)
+
+def apply_devices(spec: str):
+    """'uart=$F000 timer=$F010 pia=$F020 rom=$E000-$FFFF' biçimindeki listeyle bus'ı yeniden kurar.
+    rom= ve gap= sayfa aralığı, diğerleri cihaz taban adresi alır. (kurulan, hatalar) döndürür."""
+    engine_lib.clear_devices_dll(emulator_handle)
+    uart_bases.clear()
+    installed, errors = 0, []
+    for entry in spec.replace(';', ' ').split():
+        name, _, value = entry.partition('=')
+        name = name.lower()
+        try:
+            first, _, last = value.partition('-')
+            start = int(first.strip().lstrip('$'), 16)
+            end = int(last.strip().lstrip('$'), 16) if last else start
+            if not (0 <= start <= end <= 0xFFFF):
+                raise ValueError
+        except ValueError:
+            errors.append(f"'{entry}': geçersiz adres")
             continue
-        
-        parts = line_content.split('->', 1) 
-        if len(parts) < 2:
+        if name in ('rom', 'gap'):
+            ok = engine_lib.map_memory_dll(emulator_handle, start, end - start + 1, 1 if name == 'rom' else 3)
+        elif name in DEVICE_TYPES:
+            ok = engine_lib.attach_device_dll(emulator_handle, DEVICE_TYPES[name], start)
+            if ok and name == 'uart':
+                uart_bases.append(start)
+        else:
+            errors.append(f"'{entry}': bilinmeyen cihaz (uart, timer, pia, rom, gap)")
             continue
-            
-        code_part_str = parts[1] 
-        current_line_mc_bytes = _parse_machine_code_from_line(code_part_str)
-        machine_code_bytes_final.extend(current_line_mc_bytes)
-                    
-    print(f"Ayrıştırılan toplam makine kodu: {[f'{b:02X}' for b in machine_code_bytes_final]}")
-    return machine_code_bytes_final, org_address
+        if ok:
+            installed += 1
+        else:
+            errors.append(f"'{entry}': takılamadı (örtüşme)")
+    return installed, errors
+
+_uart_buffer = (ctypes.c_uint8 * 4096)()
+
+def poll_uart_output(window):
+    # Takılı UART'ların son çalıştırmada gönderdiği byte'ları terminale ekler
+    for base in uart_bases:
+        while True:
+            count = engine_lib.uart_take_output_dll(emulator_handle, base, _uart_buffer, len(_uart_buffer))
+            if count <= 0:
+                break
+            window['-UART_OUTPUT-'].update(bytes(_uart_buffer[:count]).decode('latin-1'), append=True)
+
+MAX_DIRTY_RANGES = 128 # 256 sayfada en fazla 128 ayrık aralık olabilir
+_dirty_starts = (ctypes.c_uint32 * MAX_DIRTY_RANGES)()
+_dirty_lengths = (ctypes.c_uint32 * MAX_DIRTY_RANGES)()
+
+def memory_window_changed(start_address, length):
+    # Son sorgudan beri motorun yazdığı sayfalardan biri pencereye değiyor mu?
+    count = engine_lib.take_dirty_ranges_dll(emulator_handle, _dirty_starts, _dirty_lengths, MAX_DIRTY_RANGES)
+    end_address = start_address + length
+    for i in range(count):
+        if _dirty_starts[i] < end_address and start_address < _dirty_starts[i] + _dirty_lengths[i]:
+            return True
+    return False
 
 def format_memory_dump(start_address, byte_list, bytes_per_line=16):
     dump_str = ""
@@ -218,13 +476,23 @@ layout_sag = [
     ],
     [
         sg.Text("A:"), sg.Input("00", size=(4,1), key='-A-', disabled=True, text_color=INPUT_TEXT_COLOR, background_color=INPUT_BG_COLOR, disabled_readonly_background_color=INPUT_BG_COLOR, disabled_readonly_text_color=DISABLED_TEXT_COLOR),
-        sg.Text("B:"), sg.Input("00", size=(4,1), key='-B-', disabled=True, text_color=INPUT_TEXT_COLOR, background_color=INPUT_BG_COLOR, disabled_readonly_background_color=INPUT_BG_COLOR, disabled_readonly_text_color=DISABLED_TEXT_COLOR)
+        sg.Text("B:"), sg.Input("00", size=(4,1), key='-B-', disabled=True, text_color=INPUT_TEXT_COLOR, background_color=INPUT_BG_COLOR, disabled_readonly_background_color=INPUT_BG_COLOR, disabled_readonly_text_color=DISABLED_TEXT_COLOR),
+        sg.Text("Çevrim:"), sg.Input("0", size=(12,1), key='-CYCLES-', disabled=True, text_color=INPUT_TEXT_COLOR, background_color=INPUT_BG_COLOR, disabled_readonly_background_color=INPUT_BG_COLOR, disabled_readonly_text_color=DISABLED_TEXT_COLOR)
     ],
     [sg.Text("CCR:"), sg.Input("C0", size=(4,1), key='-CCR_BYTE-', disabled=True, text_color=INPUT_TEXT_COLOR, background_color=INPUT_BG_COLOR, disabled_readonly_background_color=INPUT_BG_COLOR, disabled_readonly_text_color=DISABLED_TEXT_COLOR),
      sg.Checkbox("H", key='-H-', disabled=True), sg.Checkbox("I", key='-I-', disabled=True), 
      sg.Checkbox("N", key='-N-', disabled=True), sg.Checkbox("Z", key='-Z-', disabled=True), 
      sg.Checkbox("V", key='-V-', disabled=True), sg.Checkbox("C", key='-C-', disabled=True)
     ],
+    [sg.Text("Kesme/İzleme:"), sg.Input("", size=(40,1), key='-BREAKPOINTS-',
+                                        tooltip="$0105; w$0200-$020F VAL==$FF; r$0051; $0110 A==5"),
+     sg.Button("Uygula", key='-BP_APPLY-', disabled=not engine_initialized)],
+    [sg.Text("Cihazlar:"), sg.Input("", size=(40,1), key='-DEVICES-',
+                                    tooltip="uart=$F000 timer=$F010 pia=$F020 rom=$E000-$FFFF gap=$C000-$CFFF"),
+     sg.Button("Uygula", key='-DEV_APPLY-', disabled=not engine_initialized)],
+    [sg.Text("Terminal (UART):"), sg.Input("", size=(30,1), key='-UART_INPUT-'),
+     sg.Button("Gönder", key='-UART_SEND-', disabled=not engine_initialized)],
+    [sg.Multiline(size=(60, 3), key='-UART_OUTPUT-', disabled=True, autoscroll=True, font=('Courier New', 10), background_color=MEM_DUMP_BG_COLOR, text_color=MEM_DUMP_TEXT_COLOR)],
     [sg.HorizontalSeparator(color=HEADER_TEXT_COLOR)],
     [sg.Text("Bellek Görüntüleyici", font=('Helvetica', 11, 'bold' ), text_color=HEADER_TEXT_COLOR)],
     [sg.Text("Başlangıç Adresi: $"), sg.Input("0000", size=(6,1), key='-MEM_DUMP_ADDR_IN-'), 
@@ -236,8 +504,13 @@ layout_sag = [
 
 layout_alt_butonlar = [ 
     sg.Button("Çevir & Yükle", key='-ASSEMBLE_LOAD-'), 
+    sg.Button("Nesne Dosyası Yükle", key='-LOAD_OBJECT-'),
     sg.Button("Adım At (Step)", key='-STEP-', disabled=True), 
+    sg.Button("Çalıştır (Run)", key='-RUN-', disabled=True), 
+    sg.Button("Geri Adım", key='-STEP_BACK-', disabled=True), 
     sg.Button("Reset CPU", key='-RESET_CPU-', disabled=True),
+    sg.Button("NMI", key='-NMI-', disabled=not engine_initialized),
+    sg.Checkbox("IRQ hattı", key='-IRQ_LINE-', enable_events=True, disabled=not engine_initialized),
     sg.Button("Binary .txt Oluştur", key='-CREATE_BINARY_TXT-', disabled=True), 
     sg.Button("Çıkış", key='-EXIT-')
 ]
@@ -255,11 +528,12 @@ layout = [
 window = sg.Window("Motorola 6800 Assembler & Simülatör", layout, finalize=True)
 
 if engine_initialized:
-    engine_lib.reset_cpu_dll() 
-    cpu_s = engine_lib.get_cpu_state_dll()
+    engine_lib.reset_cpu_dll(emulator_handle) 
+    cpu_s = engine_lib.get_cpu_state_dll(emulator_handle)
     update_gui_registers(window, cpu_s)
 else: 
     window['-ASSEMBLE_LOAD-'].update(disabled=True)
+    window['-LOAD_OBJECT-'].update(disabled=True)
     window['-CREATE_BINARY_TXT-'].update(disabled=True)
 
 
@@ -269,6 +543,10 @@ current_org_address = 0
 last_dump_start_addr = 0 
 last_dump_num_lines = 8 
 machine_code_bytes_cache = [] 
+program_segments_cache = []  # (adres, byte'lar) listesi; reset sonrası yeniden yüklemek için
+assembly_session = None      # Artımlı derleme oturumu (create_assembly_session_dll)
+session_lines = []           # Oturumun bildiği kaynak satırları
+session_in_memory = False    # Bellekteki program oturumun son görüntüsü mü (yamalar uygulanabilir mi)
 
 while True:
     event, values = window.read()
@@ -283,57 +561,54 @@ while True:
 
     if event == '-ASSEMBLE_LOAD-':
         assembly_kodu = values['-ASM_INPUT-']
-        temp_asm_file = "temp_code.asm" 
-        with open(temp_asm_file, "w", encoding='utf-8') as f:
-            f.write(assembly_kodu)
-        
-        assembler_executable = 'main.exe' if os.name == 'nt' else './main' 
-        
         try:
-            result = subprocess.run(
-                [assembler_executable, temp_asm_file, "object_output.txt"], # Çıktı dosyası adı eklendi
-                capture_output=True, text=True, check=False, encoding='utf-8'
-            )
-            assembler_stdout = result.stdout
-            assembler_stderr = result.stderr
-            
-            full_assembler_output = "--- STDOUT ---\n" + assembler_stdout + "\n--- STDERR ---\n" + assembler_stderr
-            window['-ASM_OUTPUT-'].update(full_assembler_output)
-
-            # Hata kontrolü STDERR'e ve return code'a göre yapılıyor
-            if result.returncode != 0 or "ERROR" in assembler_stderr.upper() or "HATA" in assembler_stderr.upper():
-                error_message_to_show = assembler_stderr if assembler_stderr.strip() else assembler_stdout
-                sg.popup_error(f"Assembly çevirme hatası!\n{error_message_to_show}", title="Assembler Hatası")
+            if assembly_session is None:
+                assembly_session = engine_lib.create_assembly_session_dll()
+            session_lines, edit_output = edit_session_source(assembly_session, session_lines, assembly_kodu)
+            assembly_result = session_result(assembly_session)
+            window['-ASM_OUTPUT-'].update(format_assembly_report(assembly_result))
+
+            if assembly_result["error_count"] > 0:
+                first_errors = "\n".join(f"Satır {line_no}: {message}"
+                                         for line_no, is_error, message, _ in assembly_result["diagnostics"] if is_error)
+                sg.popup_error(f"Assembly çevirme hatası! ({assembly_result['error_count']} hata)\n{first_errors}", title="Assembler Hatası")
                 program_loaded = False
                 machine_code_bytes_cache = []
-            else: 
-                machine_code_bytes_cache, org_addr = parse_assembler_output(assembler_stdout)
-                current_org_address = org_addr 
-                
-                if machine_code_bytes_cache:
-                    code_array = (ctypes.c_uint8 * len(machine_code_bytes_cache))(*machine_code_bytes_cache)
-                    engine_lib.load_program_dll(code_array, len(machine_code_bytes_cache), org_addr)
-                    
-                    current_cpu_state = engine_lib.get_cpu_state_dll() 
-                    update_gui_registers(window, current_cpu_state)
-                    
-                    sg.popup_quick_message(f"Program belleğe ${org_addr:04X} adresinden yüklendi. PC = ${current_cpu_state.pc:04X}", auto_close_duration=3)
-                    program_loaded = True
-                else:
-                    sg.popup_error("Assembler çıktısından makine kodu ayrıştırılamadı (STDOUT boş veya hatalı).", title="Ayrıştırma Hatası")
-                    program_loaded = False
-                    machine_code_bytes_cache = []
-            
+                program_segments_cache = []
+            elif assembly_result["code"] and program_loaded and session_in_memory:
+                # Program zaten bellekte: sadece değişen byte'lar yazılır, PC ve registerlar korunur
+                written = engine_lib.apply_session_patches_dll(emulator_handle, assembly_session)
+                machine_code_bytes_cache = list(assembly_result["code"])
+                program_segments_cache = assembly_result["segments"]
+                current_org_address = assembly_result["org_address"]
+                sg.popup_quick_message(f"Artımlı derleme: {edit_output.reencoded_lines} satır yeniden kodlandı, {written} byte belleğe yazıldı (PC değişmedi)", auto_close_duration=3)
+                if window['-MEM_OUTPUT-'].get().strip():
+                    window.write_event_value('-MEM_SHOW-', None)
+            elif assembly_result["code"]:
+                machine_code_bytes_cache = list(assembly_result["code"])
+                program_segments_cache = assembly_result["segments"]
+                current_org_address = assembly_result["org_address"]
+                load_segments(program_segments_cache)
+
+                current_cpu_state = engine_lib.get_cpu_state_dll(emulator_handle)
+                update_gui_registers(window, current_cpu_state)
+
+                sg.popup_quick_message(f"Program belleğe ${current_org_address:04X} adresinden yüklendi ({len(program_segments_cache)} bölüm). PC = ${current_cpu_state.pc:04X}", auto_close_duration=3)
+                program_loaded = True
+                session_in_memory = True
+            else:
+                sg.popup_error("Assembler makine kodu üretmedi.", title="Boş Program")
+                program_loaded = False
+                machine_code_bytes_cache = []
+                program_segments_cache = []
+
             window['-STEP-'].update(disabled=not program_loaded)
+            window['-RUN-'].update(disabled=not program_loaded)
+            window['-STEP_BACK-'].update(disabled=not program_loaded)
             window['-RESET_CPU-'].update(disabled=not program_loaded)
             window['-MEM_SHOW-'].update(disabled=not program_loaded)
             window['-CREATE_BINARY_TXT-'].update(disabled=not program_loaded)
 
-
-        except FileNotFoundError:
-            output_msg = f"HATA: C++ Assembler ('{assembler_executable}') bulunamadı."
-            window['-ASM_OUTPUT-'].update(output_msg)
-            sg.popup_error(output_msg, title="Dosya Bulunamadı")
         except Exception as e:
             output_msg = f"Beklenmedik bir hata (Çevir & Yükle): {str(e)}"
             window['-ASM_OUTPUT-'].update(output_msg)
@@ -341,35 +616,99 @@ while True:
 
     elif event == '-STEP-':
         if program_loaded:
-            engine_lib.step_cpu_dll()
-            current_cpu_state = engine_lib.get_cpu_state_dll()
+            engine_lib.step_cpu_dll(emulator_handle)
+            current_cpu_state = engine_lib.get_cpu_state_dll(emulator_handle)
             update_gui_registers(window, current_cpu_state)
-            if window['-MEM_OUTPUT-'].get().strip():
+            poll_uart_output(window)
+            hit_text = watch_hit_text()
+            if hit_text:
+                sg.popup_quick_message(f"{STOP_REASON_TEXT[7]}: {hit_text}", auto_close_duration=2)
+            if window['-MEM_OUTPUT-'].get().strip() and \
+               memory_window_changed(last_dump_start_addr, last_dump_num_lines * 16):
                 start_addr_to_refresh = last_dump_start_addr
                 num_lines_to_refresh = last_dump_num_lines
                 
-                memory_bytes_list = []
-                total_bytes_to_read = num_lines_to_refresh * 16 
-                for i in range(total_bytes_to_read):
-                    current_addr = start_addr_to_refresh + i
-                    if current_addr < 65536:
-                         memory_bytes_list.append(engine_lib.read_memory_dll(current_addr))
-                    else:
-                        break
+                end_addr = min(start_addr_to_refresh + num_lines_to_refresh * 16, MEMORY_SIZE)
+                memory_bytes_list = emulator_memory[start_addr_to_refresh:end_addr]
                 formatted_dump = format_memory_dump(start_addr_to_refresh, memory_bytes_list)
                 window['-MEM_OUTPUT-'].update(formatted_dump)
         else:
             sg.popup_error(MSG_PROGRAM_YUKLENMEDI_ICERIK, title=MSG_PROGRAM_YUKLENMEDI_BASLIK)
             
+    elif event == '-RUN-':
+        if program_loaded:
+            # Tüm çalıştırma tek bir DLL çağrısında yapılır; Python'a sadece sonuç döner
+            final_state = CppCPUState()
+            steps_done = ctypes.c_uint32(0)
+            reason = engine_lib.run_cpu_dll(emulator_handle, RUN_MAX_STEPS, 0, 0, 0, None, 0, 0x0000, 0xFFFF,
+                                            ctypes.byref(final_state), ctypes.byref(steps_done))
+            update_gui_registers(window, final_state)
+            poll_uart_output(window)
+            reason_text = STOP_REASON_TEXT.get(reason, f"Bilinmeyen durma nedeni ({reason})")
+            if reason == 7:
+                reason_text += f" ({watch_hit_text()})"
+            sg.popup_quick_message(f"{reason_text}. {steps_done.value} komut, {final_state.cycles} çevrim. PC = ${final_state.pc:04X}", auto_close_duration=3)
+            if window['-MEM_OUTPUT-'].get().strip() and \
+               memory_window_changed(last_dump_start_addr, last_dump_num_lines * 16):
+                window.write_event_value('-MEM_SHOW-', None)
+        else:
+            sg.popup_error(MSG_PROGRAM_YUKLENMEDI_ICERIK, title=MSG_PROGRAM_YUKLENMEDI_BASLIK)
+
+    elif event == '-BP_APPLY-':
+        installed, errors = apply_breakpoints(values['-BREAKPOINTS-'])
+        if errors:
+            sg.popup_error("\n".join(errors), title="Kesme Noktası Hatası")
+        else:
+            sg.popup_quick_message(f"{installed} kesme/izleme noktası kuruldu.", auto_close_duration=2)
+
+    elif event == '-DEV_APPLY-':
+        installed, errors = apply_devices(values['-DEVICES-'])
+        if errors:
+            sg.popup_error("\n".join(errors), title="Cihaz Hatası")
+        else:
+            sg.popup_quick_message(f"{installed} cihaz/eşleme kuruldu.", auto_close_duration=2)
+
+    elif event == '-UART_SEND-':
+        if not uart_bases:
+            sg.popup_error("Takılı UART yok. Önce Cihazlar satırına uart=$adres yazıp uygulayın.", title="Terminal")
+        else:
+            # Enter karşılığı CR eklenir; ilk UART'ın alma kuyruğuna gider
+            data = (values['-UART_INPUT-'] + '\r').encode('latin-1', errors='replace')
+            engine_lib.uart_feed_input_dll(emulator_handle, uart_bases[0], data, len(data))
+            window['-UART_INPUT-'].update("")
+
+    elif event == '-NMI-':
+        # Bir sonraki Step/Run'da $FFFC vektörüne gidilir
+        engine_lib.trigger_nmi_dll(emulator_handle)
+        sg.popup_quick_message("NMI bekliyor; bir sonraki adımda kabul edilecek.", auto_close_duration=2)
+
+    elif event == '-IRQ_LINE-':
+        # Dış IRQ hattı işaretli kaldıkça etkindir (I bayrağı temizse $FFF8 vektörüne gidilir)
+        engine_lib.set_irq_dll(emulator_handle, 1 if values['-IRQ_LINE-'] else 0)
+
+    elif event == '-STEP_BACK-':
+        if program_loaded:
+            previous_state = CppCPUState()
+            if engine_lib.reverse_step_dll(emulator_handle, ctypes.byref(previous_state)):
+                update_gui_registers(window, previous_state)
+                if window['-MEM_OUTPUT-'].get().strip() and \
+                   memory_window_changed(last_dump_start_addr, last_dump_num_lines * 16):
+                    window.write_event_value('-MEM_SHOW-', None)
+            else:
+                sg.popup_quick_message(STOP_REASON_TEXT[6], auto_close_duration=2)
+        else:
+            sg.popup_error(MSG_PROGRAM_YUKLENMEDI_ICERIK, title=MSG_PROGRAM_YUKLENMEDI_BASLIK)
+
     elif event == '-RESET_CPU-':
         if program_loaded: 
-            engine_lib.reset_cpu_dll() 
-            if machine_code_bytes_cache and current_org_address is not None:
+            engine_lib.reset_cpu_dll(emulator_handle) 
+            if values['-IRQ_LINE-']:
+                engine_lib.set_irq_dll(emulator_handle, 1)  # Reset kesme isteklerini siler; hat hâlâ işaretli
+            if program_segments_cache:
                  print(f"Reset sonrası programı ORG ${current_org_address:04X} adresine tekrar yüklüyorum.")
-                 code_array = (ctypes.c_uint8 * len(machine_code_bytes_cache))(*machine_code_bytes_cache)
-                 engine_lib.load_program_dll(code_array, len(machine_code_bytes_cache), current_org_address)
+                 load_segments(program_segments_cache)
 
-            current_cpu_state = engine_lib.get_cpu_state_dll()
+            current_cpu_state = engine_lib.get_cpu_state_dll(emulator_handle)
             update_gui_registers(window, current_cpu_state)
             sg.popup_quick_message(f"CPU sıfırlandı. PC = ${current_cpu_state.pc:04X}", auto_close_duration=2)
             if window['-MEM_OUTPUT-'].get().strip():
@@ -400,6 +739,48 @@ while True:
         else: 
             sg.popup_error(MSG_PROGRAM_YUKLENMEDI_ICERIK, title=MSG_PROGRAM_YUKLENMEDI_BASLIK)
 
+    elif event == '-LOAD_OBJECT-':
+        object_filename = sg.popup_get_file(
+            "S19 / Intel HEX / ham binary dosyası seçin",
+            file_types=(("Nesne Dosyaları", "*.s19 *.srec *.mot *.hex *.ihx *.bin"), ("Tüm Dosyalar", "*.*")),
+            no_window=True
+        )
+        if object_filename:
+            try:
+                with open(object_filename, "rb") as f:
+                    object_bytes = f.read()
+                raw_base = 0
+                if object_filename.lower().endswith(".bin"):
+                    base_text = sg.popup_get_text("Ham görüntünün yükleneceği adres ($ olmadan, hex):", default_text="0000")
+                    if base_text is None:
+                        continue
+                    raw_base = int(base_text, 16) & 0xFFFF
+                # Biçim içerikten anlaşılır (0); ham dosyalar raw_base adresine yüklenir
+                segment_starts = (ctypes.c_uint32 * MAX_DIRTY_RANGES)()
+                segment_lengths = (ctypes.c_uint32 * MAX_DIRTY_RANGES)()
+                segment_count = engine_lib.load_object_dll(emulator_handle, object_bytes, len(object_bytes), 0, raw_base,
+                                                           segment_starts, segment_lengths, MAX_DIRTY_RANGES)
+                if segment_count < 0:
+                    sg.popup_error("Nesne dosyası okunamadı (geçersiz kayıt veya checksum). Ayrıntılar konsolda.", title="Yükleme Hatası")
+                else:
+                    current_cpu_state = engine_lib.get_cpu_state_dll(emulator_handle)
+                    # Reset sonrası yeniden yükleme için bölümler bellekten kopyalanır; PC ilk bölüme döner
+                    program_segments_cache = [(segment_starts[i], bytes(emulator_memory[segment_starts[i]:segment_starts[i] + segment_lengths[i]]))
+                                              for i in range(min(segment_count, MAX_DIRTY_RANGES))]
+                    machine_code_bytes_cache = [b for _, data in program_segments_cache for b in data]
+                    current_org_address = current_cpu_state.pc
+                    session_in_memory = False  # Bellekteki program artık oturumun görüntüsü değil
+                    update_gui_registers(window, current_cpu_state)
+                    window['-ASM_OUTPUT-'].update("\n".join(f"Bölüm ${address:04X} ({len(data)} byte)" for address, data in program_segments_cache))
+                    sg.popup_quick_message(f"{segment_count} bölüm yüklendi. PC = ${current_cpu_state.pc:04X}", auto_close_duration=3)
+                    program_loaded = True
+                    for key in ('-STEP-', '-RUN-', '-STEP_BACK-', '-RESET_CPU-', '-MEM_SHOW-', '-CREATE_BINARY_TXT-'):
+                        window[key].update(disabled=False)
+                    if window['-MEM_OUTPUT-'].get().strip():
+                        window.write_event_value('-MEM_SHOW-', None)
+            except Exception as e:
+                sg.popup_error(f"Nesne dosyası yüklenirken hata oluştu:\n{e}", title="Yükleme Hatası")
+
     elif event == '-MEM_SHOW-': 
         if program_loaded:
             try:
@@ -421,10 +802,7 @@ while True:
                     window['-MEM_OUTPUT-'].update(f"${last_dump_start_addr:04X} adresinden itibaren gösterilecek veri yok (bellek sonu).")
                     continue
 
-                memory_bytes_list = [] 
-                for i in range(total_bytes_to_read):
-                    current_addr = last_dump_start_addr + i
-                    memory_bytes_list.append(engine_lib.read_memory_dll(current_addr))
+                memory_bytes_list = emulator_memory[last_dump_start_addr:last_dump_start_addr + total_bytes_to_read]
                 
                 formatted_dump = format_memory_dump(last_dump_start_addr, memory_bytes_list, bytes_per_line)
                 window['-MEM_OUTPUT-'].update(formatted_dump)
@@ -437,3 +815,8 @@ while True:
             sg.popup_error(MSG_PROGRAM_YUKLENMEDI_ICERIK, title=MSG_PROGRAM_YUKLENMEDI_BASLIK)
     
 window.close()
+if engine_initialized:
+    emulator_memory.release()  # Görünüm, örnek yok edilmeden önce bırakılmalı
+    engine_lib.destroy_emulator_dll(emulator_handle)
+    if assembly_session is not None:
+        engine_lib.destroy_assembly_session_dll(assembly_session)
@@ -0,0 +1,710 @@
+#include "assembler.hpp"
+#include "trace.hpp"
+#include "lexer.hpp"
+#include "listing.hpp"
+#include <iomanip>
+#include <string>
+#include <algorithm>
+#include <vector> 
+#include <sstream>
+#include <cctype>
+#include <cstdint>
+
+// Mesajı ctx.messages'a ekler ve "Error (Line N, Col C): ..." biçiminde diagnostics akışına yazar
+// (sütun bilinmiyorsa 0'dır ve yazılmaz)
+static void report(AssemblyContext& ctx, int lineNumber, bool is_error, const std::string& message, int column = 0) {
+    if (is_error) ctx.error_count++;
+    ctx.messages.push_back(AssemblyDiagnostic{lineNumber, column, is_error, message});
+    ctx.diagnostics << (is_error ? "Error" : "Warning") << " (Line " << lineNumber;
+    if (column > 0) ctx.diagnostics << ", Col " << column;
+    ctx.diagnostics << "): " << message << std::endl;
+}
+
+// Kod LC'de üretilecek; son bölümün devamı değilse (ORG, SECTION veya atlanan byte'lar) yeni bölüm aç
+static void open_segment(AssemblyContext& ctx) {
+    if (ctx.segments.empty() || ctx.segments.back().section != ctx.section ||
+        ctx.segments.back().address + ctx.segments.back().length != static_cast<size_t>(ctx.LC)) {
+        ctx.segments.push_back(AssemblySegment{static_cast<uint16_t>(ctx.LC), ctx.programData.size(), 0, ctx.section});
+    }
+}
+
+void AssemblyContext::reset() {
+    symbolTable.clear();
+    forwardReferences.clear();
+    programData.clear();
+    LC = 0;
+    origin = 0;
+    has_origin = false;
+    segments.clear();
+    error_count = 0;
+    messages.clear();
+    sections.clear();
+    section_lc.clear();
+    section = -1;
+    symbol_sections.clear();
+    symbol_flags.clear();
+    relocations.clear();
+    exports.clear();
+    imports.clear();
+}
+
+// Etiketin tanımlandığı bölümü kaydeder; sadece mutlak kod varsa vektör hiç büyümez
+static void set_symbol_section(AssemblyContext& ctx, SymbolId id) {
+    if (id >= ctx.symbol_sections.size()) {
+        if (ctx.section < 0) return;
+        ctx.symbol_sections.resize(id + 1, -1);
+    }
+    ctx.symbol_sections[id] = ctx.section;
+}
+
+static void set_symbol_flag(AssemblyContext& ctx, SymbolId id, uint8_t flag) {
+    if (id >= ctx.symbol_flags.size()) ctx.symbol_flags.resize(id + 1, 0);
+    ctx.symbol_flags[id] |= flag;
+}
+
+// Geçerli bölümün LC'sini saklayıp mutlak koda döner (ORG)
+static void leave_section(AssemblyContext& ctx) {
+    if (ctx.section < 0) return;
+    ctx.section_lc[ctx.section] = ctx.LC;
+    ctx.section = -1;
+}
+
+// "SECTION ad": aynı ad tekrar açılırsa bölüm kaldığı yerden devam eder
+static void enter_section(AssemblyContext& ctx, std::string_view name) {
+    leave_section(ctx);
+    auto found = std::find(ctx.sections.begin(), ctx.sections.end(), name);
+    int index = static_cast<int>(found - ctx.sections.begin());
+    if (found == ctx.sections.end()) {
+        ctx.sections.emplace_back(name);
+        ctx.section_lc.push_back(0);
+    }
+    ctx.section = index;
+    ctx.LC = ctx.section_lc[index];
+}
+
+// Bağlayıcının dolduracağı operand: programData[offset]'ten başlayan byte'lar
+static void add_relocation(AssemblyContext& ctx, size_t offset, RelocationKind kind, SymbolId id, int line, int column) {
+    ctx.relocations.push_back(AssemblyRelocation{offset, kind, id, line, column});
+}
+
+
+// Listeleme satırları komut başına iz seviyesinde yazılır (GUI bu çıktıyı okur)
+static void emit_listing_line(const std::string& text) {
+    if (trace_instructions_enabled()) {
+        trace_message(text);
+    }
+}
+
+std::string decimal_to_hex(std::string decimalStr) {
+    if (decimalStr.empty()) return "XX";
+    try {
+        std::istringstream iss(decimalStr);
+        long long decimal_val; 
+        iss >> decimal_val;
+        std::stringstream ss;
+        if (decimal_val > 0xFFFF) decimal_val = 0xFFFF; 
+        if (decimal_val < 0) decimal_val = 0; 
+        ss << std::hex << std::setw(2) << std::setfill('0') << std::uppercase << (static_cast<int>(decimal_val) & 0xFF) ; 
+        return ss.str();
+    } catch (const std::exception& e) {
+        std::cerr << "Hata: decimal_to_hex exception: " << e.what() << " girdi: " << decimalStr << std::endl;
+        return "ER"; 
+    }
+}
+
+std::string trim_whitespace(const std::string& str) {
+    const std::string whitespace = " \t\n\r\f\v";
+    const auto strBegin = str.find_first_not_of(whitespace);
+    if (strBegin == std::string::npos)
+        return ""; 
+    const auto strEnd = str.find_last_not_of(whitespace);
+    const auto strRange = strEnd - strBegin + 1;
+    return str.substr(strBegin, strRange);
+}
+
+std::vector<uint8_t> hex_string_to_bytes(const std::string& hex_str_in) {
+    std::vector<uint8_t> bytes;
+    std::string hex_str = hex_str_in; 
+    if (hex_str.rfind("$", 0) == 0) hex_str = hex_str.substr(1);
+    else if (hex_str.rfind("0x", 0) == 0 || hex_str.rfind("0X", 0) == 0) hex_str = hex_str.substr(2);
+    std::string clean_hex_str = "";
+    for (char c : hex_str) { 
+        if (isxdigit(c)) {
+            clean_hex_str += c;
+        }
+    }
+    if (clean_hex_str.empty()) return bytes; 
+    if (clean_hex_str.length() % 2 != 0) clean_hex_str = "0" + clean_hex_str;
+    for (size_t i = 0; i < clean_hex_str.length(); i += 2) {
+        std::string byteString = clean_hex_str.substr(i, 2);
+        try {
+            uint8_t byte = static_cast<uint8_t>(std::stoi(byteString, nullptr, 16));
+            bytes.push_back(byte);
+        } catch (const std::exception& e) {
+            std::cerr << "Hata: hex_string_to_bytes stoi exception: " << e.what() << " girdi: '" << byteString << "' (orijinal: '" << hex_str_in << "')" << std::endl;
+            return {}; 
+        }
+    }
+    return bytes;
+}
+
+
+// Komutun operand byte'ları. M6800 komutlarında en fazla iki operand byte'ı olduğu için
+// vector yerine sabit dizi kullanılır; satır başına bellek ayrılmaz.
+struct OperandBytes {
+    uint8_t bytes[2] = {0, 0};
+    size_t count = 0;
+
+    void set(uint8_t value) { bytes[0] = value; count = 1; }
+    void set_word(int value) {
+        bytes[0] = static_cast<uint8_t>((value >> 8) & 0xFF);
+        bytes[1] = static_cast<uint8_t>(value & 0xFF);
+        count = 2;
+    }
+    void set_placeholder() { bytes[0] = bytes[1] = 0xEE; count = 2; }
+};
+
+// hex_string_to_bytes ile aynı kurallar ('$' veya '0x' öneki atılır, hex olmayan karakterler
+// yok sayılır, tek sayıda basamakta başa 0 eklenir) ama bellek ayırmaz. Toplam byte sayısını
+// döndürür; ilk iki byte out'a yazılır.
+static size_t hex_operand_bytes(std::string_view text, uint8_t out[2]) {
+    if (!text.empty() && text[0] == '$') text.remove_prefix(1);
+    else if (text.size() >= 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) text.remove_prefix(2);
+    size_t digits = 0;
+    for (char c : text) if (isxdigit(static_cast<unsigned char>(c))) digits++;
+    if (digits == 0) return 0;
+    out[0] = out[1] = 0;
+    size_t nibble = digits % 2; // Tek sayıda basamakta ilk nibble 0'dır
+    for (char c : text) {
+        if (!isxdigit(static_cast<unsigned char>(c))) continue;
+        int value = (c <= '9') ? c - '0' : (toupper(static_cast<unsigned char>(c)) - 'A' + 10);
+        size_t index = nibble / 2;
+        if (index < 2) out[index] = static_cast<uint8_t>((out[index] << 4) | value);
+        nibble++;
+    }
+    return (digits + 1) / 2;
+}
+
+// Sayısal operand: '$' ile onaltılık, yoksa ondalık. Sayı değilse veya $FFFF'i aşıyorsa false
+static bool parse_operand_value(std::string_view text, int& out) {
+    int base = 10;
+    if (!text.empty() && text[0] == '$') { base = 16; text.remove_prefix(1); }
+    if (text.empty()) return false;
+    long value = 0;
+    for (char c : text) {
+        int digit = 0;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (base == 16 && isxdigit(static_cast<unsigned char>(c))) digit = toupper(static_cast<unsigned char>(c)) - 'A' + 10;
+        else return false;
+        value = value * base + digit;
+        if (value > 0xFFFF) return false;
+    }
+    out = static_cast<int>(value);
+    return true;
+}
+
+// ORG değeri: std::stoi(..., 16) gibi isteğe bağlı '0x' öneki, en az bir hex basamak
+static bool parse_org_value(std::string_view text, int& out) {
+    size_t p = 0;
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X') && isxdigit(static_cast<unsigned char>(text[2]))) p = 2;
+    size_t start = p;
+    long long value = 0;
+    for (; p < text.size() && isxdigit(static_cast<unsigned char>(text[p])); ++p) {
+        int digit = (text[p] <= '9') ? text[p] - '0' : (toupper(static_cast<unsigned char>(text[p])) - 'A' + 10);
+        value = value * 16 + digit;
+        if (value > INT32_MAX) return false;
+    }
+    if (p == start) return false;
+    out = static_cast<int>(value);
+    return true;
+}
+
+// Listeleme satırı sadece iz açıkken oluşturulur
+static void emit_listing_line(std::string_view statement, const char* suffix) {
+    if (trace_instructions_enabled()) {
+        trace_message(std::string(statement) + suffix);
+    }
+}
+
+// Bilinen adres: $FF'e sığıyorsa ve komutun DIRECT biçimi varsa DIRECT, yoksa EXTENDED
+static void resolve_label_operand(const AssemblyContext& ctx, std::string_view mnemonic, int address,
+                                  AddressingMode& mode, OperandBytes& operand) {
+    if (ctx.instructionSet.find_instruction(mnemonic, AddressingMode::DIRECT) != nullptr && address <= 0xFF) {
+        mode = AddressingMode::DIRECT;
+        operand.set(static_cast<uint8_t>(address & 0xFF));
+    } else if (ctx.instructionSet.find_instruction(mnemonic, AddressingMode::EXTENDED) != nullptr) {
+        mode = AddressingMode::EXTENDED;
+        operand.set_word(address);
+    }
+}
+
+// Etiket adı gibi görünen operand: harf veya '_' ile başlar (sayılar ve "#$.." burada değildir)
+static bool is_symbol_operand(std::string_view text) {
+    return !text.empty() && (isalpha(static_cast<unsigned char>(text[0])) || text[0] == '_');
+}
+
+void patch_forward_references(AssemblyContext& ctx, SymbolId id, int address) {
+    const int target_section = ctx.symbol_section(id);
+    ctx.forwardReferences.resolve(id, [&](const ForwardReference& ref) {
+        if (ref.relative && ref.section != target_section) {
+            // Bölümler arası dallanma: uzaklık ancak bölümler yerleştirilince bilinir
+            add_relocation(ctx, ref.offset, RelocationKind::RELATIVE8, id, ref.line, ref.column);
+        } else if (ref.relative) {
+            int distance = address - (ref.address + ref.width);
+            if (distance < -128 || distance > 127) {
+                report(ctx, ref.line, true, "Branch target '" + std::string(ctx.symbolTable.name(id))
+                     + "' out of range (" + std::to_string(distance) + " bytes)", ref.column);
+                return;
+            }
+            ctx.programData[ref.offset] = static_cast<uint8_t>(distance & 0xFF);
+        } else if (ref.width == 2) {
+            ctx.programData[ref.offset] = static_cast<uint8_t>((address >> 8) & 0xFF);
+            ctx.programData[ref.offset + 1] = static_cast<uint8_t>(address & 0xFF);
+            if (target_section >= 0) add_relocation(ctx, ref.offset, RelocationKind::ABSOLUTE16, id, ref.line, ref.column);
+        } else if (target_section >= 0) {
+            report(ctx, ref.line, true, "8-bit immediate cannot refer to relocatable symbol '"
+                 + std::string(ctx.symbolTable.name(id)) + "'", ref.column);
+            return;
+        } else {
+            ctx.programData[ref.offset] = static_cast<uint8_t>(address & 0xFF);
+        }
+        if (trace_instructions_enabled()) {
+            std::ostringstream listing;
+            listing << std::hex << std::uppercase << std::setfill('0') << "  (Backpatch $" << std::setw(4) << ref.address
+                    << " <- " << ctx.symbolTable.name(id) << ", line " << std::dec << ref.line << ")";
+            trace_message(listing.str());
+        }
+    });
+}
+
+// Dallanma hedefine (PC = komuttan sonraki adres) 8 bit işaretli uzaklık; sığmıyorsa false
+static bool branch_distance(int target, int next_pc, OperandBytes& operand) {
+    int distance = target - next_pc;
+    if (distance < -128 || distance > 127) return false;
+    operand.set(static_cast<uint8_t>(distance & 0xFF));
+    return true;
+}
+
+// "$xx" / "$xxxx" adres operandı: bir byte DIRECT, iki byte EXTENDED. Komutun DIRECT biçimi
+// yoksa (JMP, JSR) bir byte'lık adres EXTENDED olarak yazılır. Adres okunamazsa false.
+static bool resolve_address_operand(const AssemblyContext& ctx, std::string_view mnemonic, std::string_view operand_text,
+                                    AddressingMode& mode, OperandBytes& operand) {
+    uint8_t bytes[2];
+    size_t count = hex_operand_bytes(operand_text.substr(1), bytes);
+    if (count == 1 && ctx.instructionSet.find_instruction(mnemonic, AddressingMode::DIRECT) != nullptr) {
+        mode = AddressingMode::DIRECT;
+        operand.set(bytes[0]);
+    } else if (count == 1) {
+        mode = AddressingMode::EXTENDED;
+        operand.set_word(bytes[0]);
+    } else if (count == 2) {
+        mode = AddressingMode::EXTENDED;
+        operand.bytes[0] = bytes[0];
+        operand.bytes[1] = bytes[1];
+        operand.count = 2;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Satır bittiğinde (hangi return'den çıkılırsa çıkılsın) yapılandırılmış listelemeye kaydını ekler
+struct ListingRecorder {
+    AssemblyContext& ctx;
+    const LexedLine& lexed;
+    int line;
+    int start_lc;
+    size_t start_offset;
+    int start_errors;
+    int cycles = 0;
+
+    ~ListingRecorder() {
+        if (ctx.listing == nullptr) return;
+        const size_t length = ctx.programData.size() - start_offset;
+        ListingKind kind = ListingKind::DIRECTIVE; // Hatalı satırlar finish() içinde ERROR olur
+        if (length > 0) kind = ListingKind::INSTRUCTION;
+        else if (lexed.mnemonic.empty()) kind = ListingKind::LABEL;
+        // Direktifin adresi yeni LC'dir (ORG $1000 -> 1000); hatalı satırda başladığı adres
+        const int address = (kind == ListingKind::DIRECTIVE && ctx.error_count == start_errors) ? ctx.LC : start_lc;
+        ctx.listing->add(line, address, ctx.section, start_offset, nullptr, length, cycles, kind, lexed.statement, lexed.label.text);
+    }
+};
+
+void parse(AssemblyContext& ctx, std::string_view line, int lineNumber)
+{
+    int& LC = ctx.LC;
+
+    LexedLine lexed;
+    const bool lexed_ok = lex_line(line, lexed);
+    const std::string_view statement = lexed.statement; // Yorumsuz, kırpılmış satır
+
+    if (statement.empty()) { // Boş satır veya sadece yorum
+        return;
+    }
+    ListingRecorder recorder{ctx, lexed, lineNumber, LC, ctx.programData.size(), ctx.error_count};
+
+    if (!lexed_ok)
+    {
+        report(ctx, lineNumber, true, "Syntax error: '" + std::string(statement) + "'", lexed.error_column);
+        emit_listing_line(statement, " -> ERROR (Syntax)");
+        return;
+    }
+
+    std::string_view instruction_mnemonic = lexed.mnemonic.text;
+    const std::string_view operand_text = lexed.value_operand.text;
+    // Hata mesajlarında operandın (yoksa mnemonic'in) sütunu gösterilir
+    const int operand_column = lexed.value_operand.empty() ? lexed.mnemonic.column : lexed.value_operand.column;
+
+    if (!lexed.label.empty())
+    {
+        // Etiket adı arenaya bir kez kopyalanır; tablo SymbolId ile indekslenir
+        SymbolId label_id = ctx.symbolTable.intern(lexed.label.text);
+        if (ctx.flags(label_id) & SYMBOL_IMPORTED)
+        {
+            report(ctx, lineNumber, true, "Symbol '" + std::string(lexed.label.text) + "' is declared XREF and cannot be defined", lexed.label.column);
+        }
+        else if (!ctx.symbolTable.define(label_id, LC))
+        {
+            report(ctx, lineNumber, true, "Duplicate symbol '" + std::string(lexed.label.text) + "'", lexed.label.column);
+        }
+        else
+        {
+            set_symbol_section(ctx, label_id);
+            if (instruction_mnemonic.empty() && trace_instructions_enabled())
+            {
+                std::ostringstream listing;
+                listing << statement << " -> (Label Definition at $" << std::hex << std::uppercase << LC << ")";
+                trace_message(listing.str());
+            }
+            patch_forward_references(ctx, label_id, LC);
+        }
+    }
+
+    if (instruction_mnemonic.empty()) { // Sadece etiket tanımı
+        return;
+    }
+
+    if (instruction_mnemonic == "ORG")
+    {
+        emit_listing_line(statement, " -> (Directive)");
+        if (!operand_text.empty())
+        {
+            std::string_view org_val_str = operand_text;
+            if (org_val_str[0] == '$') {
+                org_val_str.remove_prefix(1);
+            }
+            int org_value = 0;
+            if (parse_org_value(org_val_str, org_value)) {
+                leave_section(ctx);
+                LC = org_value;
+                if (!ctx.has_origin) { // Program ilk ORG adresinden itibaren yüklenir
+                    ctx.origin = LC;
+                    ctx.has_origin = true;
+                }
+            } else {
+                report(ctx, lineNumber, true, "Invalid ORG value '" + std::string(operand_text) + "'", operand_column);
+            }
+        }
+        return; 
+    }
+    
+    if (instruction_mnemonic == "END") {
+        emit_listing_line(statement, " -> (Directive)");
+        return; 
+    }
+
+    if (instruction_mnemonic == "SECTION")
+    {
+        emit_listing_line(statement, " -> (Directive)");
+        if (!lexed.register_operand.empty() || !is_symbol_operand(operand_text)) {
+            report(ctx, lineNumber, true, "Invalid SECTION name '" + std::string(operand_text) + "'", operand_column);
+            return;
+        }
+        enter_section(ctx, operand_text);
+        return;
+    }
+
+    if (instruction_mnemonic == "XDEF" || instruction_mnemonic == "XREF")
+    {
+        emit_listing_line(statement, " -> (Directive)");
+        const bool is_export = (instruction_mnemonic == "XDEF");
+        // "XDEF A", "XDEF A,B" veya "XREF A,B,C": ilk adlar register operandında
+        auto declare = [&](std::string_view name, int column) {
+            name = name.substr(0, name.find_last_not_of(" \t") + 1);
+            name.remove_prefix(std::min(name.find_first_not_of(" \t"), name.size()));
+            if (!is_symbol_operand(name)) {
+                report(ctx, lineNumber, true, "Invalid symbol name '" + std::string(name) + "'", column);
+                return;
+            }
+            SymbolId id = ctx.symbolTable.intern(name);
+            const uint8_t flags = ctx.flags(id);
+            if (is_export && (flags & SYMBOL_IMPORTED)) {
+                report(ctx, lineNumber, true, "Symbol '" + std::string(name) + "' is declared both XDEF and XREF", column);
+            } else if (!is_export && ((flags & SYMBOL_EXPORTED) || ctx.symbolTable.value(id).has_value())) {
+                report(ctx, lineNumber, true, "Symbol '" + std::string(name) + "' is defined in this module and cannot be XREF", column);
+            } else if (!(flags & (is_export ? SYMBOL_EXPORTED : SYMBOL_IMPORTED))) {
+                set_symbol_flag(ctx, id, is_export ? SYMBOL_EXPORTED : SYMBOL_IMPORTED);
+                (is_export ? ctx.exports : ctx.imports).push_back(SymbolDeclaration{id, lineNumber, column});
+            }
+        };
+        std::string_view names = lexed.register_operand.text;
+        while (!names.empty()) {
+            size_t comma = names.find(',');
+            declare(names.substr(0, comma), lexed.register_operand.column);
+            if (comma == std::string_view::npos) break;
+            names.remove_prefix(comma + 1);
+        }
+        declare(operand_text, operand_column);
+        return;
+    }
+
+    if (instruction_mnemonic == "LDA" && ctx.instructionSet.is_instruction("LDAA")) instruction_mnemonic = "LDAA";
+    if (instruction_mnemonic == "STA" && ctx.instructionSet.is_instruction("STAA")) instruction_mnemonic = "STAA";
+
+    if (!ctx.instructionSet.is_instruction(instruction_mnemonic))
+    {
+        report(ctx, lineNumber, true, "Invalid instruction '" + std::string(instruction_mnemonic) + "'", lexed.mnemonic.column);
+        emit_listing_line(statement, " -> ERROR (Invalid Instruction)");
+        return;
+    }
+
+    AddressingMode determined_mode = AddressingMode::NONE;
+    OperandBytes operand;
+    // Etiket operandı henüz tanımlı değilse operand byte'ları yer tutucu olarak yazılır ve
+    // etiket tanımlanınca patch_forward_references ile doldurulur
+    SymbolId forward_symbol = INVALID_SYMBOL;
+    bool forward_relative = false;
+    // Bir SECTION'daki etikete başvuru: operand bağlama sırasında doldurulur
+    SymbolId relocation_symbol = INVALID_SYMBOL;
+    RelocationKind relocation_kind = RelocationKind::ABSOLUTE16;
+    const bool label_operand = lexed.register_operand.empty() && is_symbol_operand(operand_text);
+
+    // Etiketli mutlak adres operandı: tanımlıysa DIRECT/EXTENDED, değilse EXTENDED + yama
+    auto resolve_symbol_operand = [&]() {
+        SymbolId id = ctx.symbolTable.intern(operand_text);
+        auto symbol_val = ctx.symbolTable.value(id);
+        if (symbol_val.has_value() && ctx.symbol_section(id) >= 0) {
+            if (ctx.instructionSet.find_instruction(instruction_mnemonic, AddressingMode::EXTENDED) != nullptr) {
+                determined_mode = AddressingMode::EXTENDED; // Son adres bilinmediği için DIRECT seçilemez
+                operand.set_word(symbol_val.value());
+                relocation_symbol = id;
+            }
+        } else if (symbol_val.has_value()) {
+            resolve_label_operand(ctx, instruction_mnemonic, symbol_val.value(), determined_mode, operand);
+        } else if (ctx.instructionSet.find_instruction(instruction_mnemonic, AddressingMode::EXTENDED) != nullptr) {
+            determined_mode = AddressingMode::EXTENDED;
+            operand.set_placeholder();
+            forward_symbol = id;
+        }
+    };
+
+    // Operand hatası bildirildiyse eksik operand byte'ları için ayrıca hata verilmez
+    bool operand_error = false;
+    auto operand_fail = [&](const std::string& message) {
+        report(ctx, lineNumber, true, message, operand_column);
+        operand_error = true;
+    };
+
+    // "#değer" / "#ETIKET": byte sayısı komutun IMMEDIATE biçiminden gelir (LDX/CPX/LDS 16 bit)
+    auto resolve_immediate_operand = [&]() {
+        determined_mode = AddressingMode::IMMEDIATE;
+        const Instruction* variant = ctx.instructionSet.find_instruction(instruction_mnemonic, AddressingMode::IMMEDIATE);
+        if (variant == nullptr) return; // Varyant hatası aşağıda bildirilir
+        const size_t width = variant->no_of_bytes > 1 ? variant->no_of_bytes - 1 : 0;
+        const std::string_view value_text = operand_text.substr(1);
+        int value = 0;
+        if (is_symbol_operand(value_text)) {
+            SymbolId id = ctx.symbolTable.intern(value_text);
+            auto symbol_val = ctx.symbolTable.value(id);
+            const bool relocatable = symbol_val.has_value() ? ctx.symbol_section(id) >= 0 : (ctx.flags(id) & SYMBOL_IMPORTED) != 0;
+            if (relocatable && width != 2) {
+                operand_fail("8-bit immediate cannot refer to relocatable symbol '" + std::string(value_text) + "'");
+            } else if (!symbol_val.has_value()) {
+                if (width == 2) operand.set_placeholder(); else operand.set(0xEE);
+                forward_symbol = id;
+            } else {
+                if (width == 2) operand.set_word(symbol_val.value()); else operand.set(static_cast<uint8_t>(symbol_val.value() & 0xFF));
+                if (relocatable) relocation_symbol = id;
+            }
+        } else if (!parse_operand_value(value_text, value) || value > (width == 2 ? 0xFFFF : 0xFF)) {
+            operand_fail("Invalid " + std::to_string(width * 8) + "-bit immediate value '" + std::string(operand_text) + "'");
+        } else if (width == 2) {
+            operand.set_word(value);
+        } else {
+            operand.set(static_cast<uint8_t>(value));
+        }
+    };
+
+    // Adresleme modu operandın biçiminden belirlenir; dallanmalar dışında bütün komutlar aynı yoldan geçer
+    const Instruction* first_variant = ctx.instructionSet.first_variant(instruction_mnemonic);
+    if (first_variant != nullptr && first_variant->addressing_mode == AddressingMode::RELATIVE) {
+        // Bcc/BRA/BSR: hedef etiket veya "$xxxx" adresi, uzaklık komuttan sonraki PC'ye göre
+        determined_mode = AddressingMode::RELATIVE;
+        const int next_pc = LC + first_variant->no_of_bytes;
+        uint8_t bytes[2];
+        size_t count = 0;
+        if (label_operand) {
+            SymbolId id = ctx.symbolTable.intern(operand_text);
+            auto target = ctx.symbolTable.value(id);
+            if (!target.has_value()) {
+                operand.set(0xEE);
+                forward_symbol = id;
+                forward_relative = true;
+            } else if (ctx.symbol_section(id) != ctx.section) {
+                operand.set(0xEE);
+                relocation_symbol = id;
+                relocation_kind = RelocationKind::RELATIVE8;
+            } else if (!branch_distance(target.value(), next_pc, operand)) {
+                report(ctx, lineNumber, true, "Branch target '" + std::string(operand_text) + "' out of range ("
+                     + std::to_string(target.value() - next_pc) + " bytes)", operand_column);
+                operand.set(0xEE);
+            }
+        } else if (ctx.section >= 0 && !operand_text.empty() && operand_text[0] == '$') {
+            report(ctx, lineNumber, true, "Absolute branch target '" + std::string(operand_text)
+                 + "' in SECTION " + ctx.sections[ctx.section], operand_column);
+            operand.set(0xEE);
+        } else if (!operand_text.empty() && operand_text[0] == '$'
+                   && (count = hex_operand_bytes(operand_text.substr(1), bytes)) >= 1 && count <= 2) {
+            int target = (count == 2) ? (bytes[0] << 8) | bytes[1] : bytes[0];
+            if (!branch_distance(target, next_pc, operand)) {
+                report(ctx, lineNumber, true, "Branch target '" + std::string(operand_text) + "' out of range ("
+                     + std::to_string(target - next_pc) + " bytes)", operand_column);
+                operand.set(0xEE);
+            }
+        } else {
+            report(ctx, lineNumber, true, "Invalid branch target '" + std::string(operand_text) + "'", operand_column);
+            operand.set(0xEE);
+        }
+    } else if (!lexed.register_operand.empty()) {
+        // "n,X": 8 bit işaretsiz uzaklık
+        int offset = 0;
+        determined_mode = AddressingMode::INDEXED;
+        if (operand_text != "X" && operand_text != "x") {
+            operand_fail("Invalid index register '" + std::string(operand_text) + "' (expected X)");
+        } else if (!parse_operand_value(lexed.register_operand.text, offset) || offset > 0xFF) {
+            operand_fail("Invalid index offset '" + std::string(lexed.register_operand.text) + "'");
+        } else {
+            operand.set(static_cast<uint8_t>(offset));
+        }
+    } else if (operand_text.empty()) {
+        determined_mode = AddressingMode::IMPLIED;
+    } else if (operand_text[0] == '#') {
+        resolve_immediate_operand();
+    } else if (operand_text[0] == '$') {
+        if (!resolve_address_operand(ctx, instruction_mnemonic, operand_text, determined_mode, operand)) {
+            operand_fail("Invalid address '" + std::string(operand_text) + "'");
+        }
+    } else if (label_operand) {
+        resolve_symbol_operand(); // LDAA/JSR/LDX ETIKET ...
+    } else {
+        int address = 0;
+        if (parse_operand_value(operand_text, address)) {
+            resolve_label_operand(ctx, instruction_mnemonic, address, determined_mode, operand); // Ondalık adres
+        } else {
+            operand_fail("Invalid operand '" + std::string(operand_text) + "'");
+        }
+    }
+
+    const Instruction* ins_data = ctx.instructionSet.find_instruction(instruction_mnemonic, determined_mode);
+    
+    if (ins_data == nullptr)
+    {
+        if (!operand_error) {
+            report(ctx, lineNumber, true, "No instruction variant found for '" + std::string(instruction_mnemonic)
+                 + "' that matches determined addressing mode (" + std::to_string(static_cast<int>(determined_mode))
+                 + "). Operand: '" + std::string(operand_text) + "'", operand_column);
+        }
+        emit_listing_line(statement, " -> ERROR (Opcode/Mode Mismatch)");
+        const Instruction* any_variant = ctx.instructionSet.first_variant(instruction_mnemonic);
+        if (any_variant != nullptr) LC += any_variant->no_of_bytes; else LC +=1; 
+        return;
+    }
+    
+    const Instruction& instructionData = *ins_data;
+
+    const bool echo_listing = trace_instructions_enabled();
+    std::string listing;
+    if (echo_listing) listing = std::string(statement) + " -> " + decimal_to_hex(std::to_string(instructionData.opcode));
+    open_segment(ctx);
+    ctx.programData.push_back(instructionData.opcode); 
+    recorder.cycles = instructionData.cycles;
+
+    if (forward_symbol != INVALID_SYMBOL) {
+        ctx.forwardReferences.add_reference(ForwardReference{forward_symbol, ctx.programData.size(), LC + 1,
+                                                             static_cast<uint8_t>(operand.count), forward_relative,
+                                                             lineNumber, operand_column, ctx.section});
+    }
+    if (relocation_symbol != INVALID_SYMBOL) {
+        add_relocation(ctx, ctx.programData.size(), relocation_kind, relocation_symbol, lineNumber, operand_column);
+    }
+    const bool unresolved = (forward_symbol != INVALID_SYMBOL || relocation_symbol != INVALID_SYMBOL);
+    for (size_t i = 0; i < operand.count; ++i) { 
+        if (echo_listing) listing += unresolved ? " ??" : " " + decimal_to_hex(std::to_string(operand.bytes[i]));
+        ctx.programData.push_back(operand.bytes[i]); 
+    }
+    
+    // Eksik operand byte'ı her zaman hatadır; LC'nin kaymaması için yerleri 0 ile doldurulur
+    size_t expected_operand_bytes = instructionData.no_of_bytes > 0 ? instructionData.no_of_bytes - 1 : 0;
+    if (operand.count < expected_operand_bytes) {
+        if (!operand_error) {
+            report(ctx, lineNumber, true, "Missing operand for '" + std::string(instruction_mnemonic) + "' ("
+                 + std::to_string(expected_operand_bytes) + " byte(s) expected)", operand_column);
+        }
+        for (size_t i = operand.count; i < expected_operand_bytes; ++i) {
+            if (echo_listing) listing += " XX"; 
+            ctx.programData.push_back(0x00); 
+        }
+    } else if (operand.count > expected_operand_bytes) {
+        report(ctx, lineNumber, false, "Too many operand bytes generated for " + std::string(instruction_mnemonic), operand_column);
+    }
+    
+    if (echo_listing) emit_listing_line(listing);
+    ctx.segments.back().length = ctx.programData.size() - ctx.segments.back().offset;
+    LC += instructionData.no_of_bytes;
+}
+
+void finish_assembly(AssemblyContext& ctx) {
+    ctx.forwardReferences.for_each_pending([&](const ForwardReference& ref) {
+        if (ctx.flags(ref.symbol) & SYMBOL_IMPORTED) {
+            add_relocation(ctx, ref.offset, ref.relative ? RelocationKind::RELATIVE8 : RelocationKind::ABSOLUTE16,
+                           ref.symbol, ref.line, ref.column);
+            return;
+        }
+        report(ctx, ref.line, true, "Undefined symbol '" + std::string(ctx.symbolTable.name(ref.symbol)) + "'", ref.column);
+    });
+    for (const SymbolDeclaration& declaration : ctx.exports) {
+        if (!ctx.symbolTable.value(declaration.symbol).has_value()) {
+            report(ctx, declaration.line, true, "Exported symbol '" + std::string(ctx.symbolTable.name(declaration.symbol))
+                 + "' is not defined", declaration.column);
+        }
+    }
+    if (ctx.listing != nullptr) ctx.listing->finish(ctx); // Yamalar ve mesajlar tamamlandı
+}
+
+// Kaynak metni satırlara böler ('\n'; '\r' lexer'da boşluk sayılır) ve kopyalamadan parse eder
+int assemble_buffer(AssemblyContext& ctx, std::string_view source) {
+    int lineNumber = 0;
+    size_t pos = 0;
+    while (pos < source.size())
+    {
+        size_t end = source.find('\n', pos);
+        if (end == std::string_view::npos) end = source.size();
+        lineNumber++;
+        parse(ctx, source.substr(pos, end - pos), lineNumber);
+        pos = end + 1;
+    }
+    finish_assembly(ctx);
+    return lineNumber;
+}
+
+int assemble_stream(AssemblyContext& ctx, std::istream& source) {
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(source, line))
+    {
+        lineNumber++;
+        parse(ctx, line, lineNumber); // Bu fonksiyon ctx.programData vektörünü doldurur
+    }
+    finish_assembly(ctx);
+    return lineNumber;
+}
@@ -0,0 +1,111 @@
+#ifndef ASSEMBLER_HPP
+#define ASSEMBLER_HPP
+
+#include "main.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+class AssemblyListing;
+
+// Ardışık adreslere yerleşen kod parçası; byte'ları programData[offset, offset+length)
+struct AssemblySegment {
+    uint16_t address;     // SECTION içindeyse bölüm başına göre ofset
+    size_t offset;
+    size_t length;
+    int section = -1;     // AssemblyContext::sections indeksi; -1 mutlak (ORG) kod
+};
+
+// Yeniden konumlandırma kaydı: bağlayıcı (linker) programData[offset]'teki operandı sembolün
+// son adresiyle doldurur. ABSOLUTE16 iki byte (yüksek byte önce), RELATIVE8 ise offset + 1
+// adresine göre 8 bit işaretli uzaklıktır.
+enum class RelocationKind : uint8_t {
+    ABSOLUTE16,
+    RELATIVE8
+};
+
+struct AssemblyRelocation {
+    size_t offset;
+    RelocationKind kind;
+    SymbolId symbol;
+    int line;
+    int column;
+};
+
+// XDEF / XREF ile bildirilen sembol ve bildirimin yeri
+struct SymbolDeclaration {
+    SymbolId symbol;
+    int line;
+    int column;
+};
+
+// symbol_flags değerleri
+constexpr uint8_t SYMBOL_EXPORTED = 1; // XDEF: diğer modüller kullanabilir
+constexpr uint8_t SYMBOL_IMPORTED = 2; // XREF: başka bir modülde tanımlı
+
+struct AssemblyDiagnostic {
+    int line;
+    int column;           // 1'den başlar; bilinmiyorsa 0
+    bool is_error;        // false ise uyarı
+    std::string message;
+};
+
+// Tek bir kaynağın derleme durumu. Global durum kullanılmadığı için farklı
+// bağlamlar farklı iş parçacıklarında aynı anda derlenebilir; komut seti
+// sadece okunur ve hepsi tarafından paylaşılabilir.
+struct AssemblyContext {
+    explicit AssemblyContext(const InstructionSet& set, std::ostream& diagnostics_stream = std::cerr)
+        : instructionSet(set), diagnostics(diagnostics_stream) {}
+
+    const InstructionSet& instructionSet;
+    SymbolTable symbolTable;
+    ForwardReferenceTable forwardReferences; // Tanımından önce kullanılan etiketlerin yamaları
+    std::vector<uint8_t> programData; // Üretilen makine kodu
+    int LC = 0;                       // Konum sayacı
+    int origin = 0;                   // İlk ORG adresi (program buradan yüklenir)
+    bool has_origin = false;
+    std::vector<AssemblySegment> segments; // Her ORG (veya adres boşluğu) yeni bölüm başlatır
+    int error_count = 0;
+    std::vector<AssemblyDiagnostic> messages;
+    std::ostream& diagnostics;        // Aynı mesajlar "Error (Line N, Col C): ..." biçiminde
+    AssemblyListing* listing = nullptr; // Ayarlıysa her satır listing.hpp'deki yapılandırılmış listelemeye eklenir
+
+    // Yeniden konumlandırılabilir modül (SECTION / XDEF / XREF). Sadece ORG kullanan
+    // kaynaklarda bunların hepsi boş kalır ve çıktı mutlak programdır.
+    std::vector<std::string> sections;      // Bölüm adları, ilk görülme sırasıyla
+    std::vector<int> section_lc;            // Her bölümün kaldığı konum (bölüm başına göre)
+    int section = -1;                       // Geçerli bölüm; -1 mutlak kod (ORG)
+    std::vector<int> symbol_sections;       // SymbolId -> tanımlandığı bölüm (yoksa -1)
+    std::vector<uint8_t> symbol_flags;      // SymbolId -> SYMBOL_EXPORTED | SYMBOL_IMPORTED
+    std::vector<AssemblyRelocation> relocations;
+    std::vector<SymbolDeclaration> exports;  // XDEF sırasıyla
+    std::vector<SymbolDeclaration> imports;  // XREF sırasıyla
+
+    bool is_relocatable() const { return !sections.empty() || !symbol_flags.empty(); }
+    int symbol_section(SymbolId id) const { return id < symbol_sections.size() ? symbol_sections[id] : -1; }
+    uint8_t flags(SymbolId id) const { return id < symbol_flags.size() ? symbol_flags[id] : 0; }
+
+    // Bağlamı komut seti, mesaj akışı ve listeleme hedefi dışında boş duruma döndürür
+    void reset();
+};
+
+std::string decimal_to_hex(std::string decimalStr);
+std::string trim_whitespace(const std::string& str);
+std::vector<uint8_t> hex_string_to_bytes(const std::string& hex_str_in);
+
+// Tek bir kaynak satırını işler; makine kodu ctx.programData'ya eklenir
+void parse(AssemblyContext& ctx, std::string_view line, int lineNumber);
+// Etiket tanımlandığında (id -> address) ona yapılmış ileri başvuruların operand
+// byte'larını programData'da yerinde yamalar; menzil dışı dallanmaları hata olarak bildirir
+void patch_forward_references(AssemblyContext& ctx, SymbolId id, int address);
+// Geçişi bitirir: hiç tanımlanmayan etiketlere yapılan başvuruları hata olarak bildirir
+// (XREF ile dışarıdan alınan etiketlerin başvuruları yeniden konumlandırma kaydına dönüşür)
+void finish_assembly(AssemblyContext& ctx);
+// Akıştaki tüm satırları sırayla parse eder ve geçişi bitirir; okunan satır sayısını döndürür
+int assemble_stream(AssemblyContext& ctx, std::istream& source);
+// Bellekteki (ör. MappedFile ile eşlenmiş) kaynağı satır kopyalamadan parse eder ve geçişi bitirir
+int assemble_buffer(AssemblyContext& ctx, std::string_view source);
+
+#endif // ASSEMBLER_HPP
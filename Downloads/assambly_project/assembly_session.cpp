@@ -0,0 +1,400 @@
+#include "assembly_session.hpp"
+#include "lexer.hpp"
+#include "listing.hpp"
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+AssemblySession::AssemblySession(const InstructionSet& set)
+    : instructionSet(set), scratch(set, null_stream), image(0x10000, 0), written(0x10000, 0),
+      staged(0x10000, 0), staged_stamp(0x10000, 0), cover(0x10000, 0), contested_flag(0x10000, 0) {}
+
+size_t AssemblySession::edit(size_t first_line, size_t line_count, std::string_view text) {
+    first_line = std::min(first_line, order.size());
+    line_count = std::min(line_count, order.size() - first_line);
+
+    for (size_t i = 0; i < line_count; ++i) remove_line(order[first_line + i]);
+
+    // Yeni satırlar assemble_buffer ile aynı kuralla bölünür
+    std::vector<uint32_t> inserted;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) end = text.size();
+        inserted.push_back(add_line(text.substr(pos, end - pos)));
+        pos = end + 1;
+    }
+
+    if (inserted.size() == line_count) {
+        // Satır sayısı değişmedi (editörde tek satır düzenleme): sıralar aynı kalır
+        for (size_t i = 0; i < inserted.size(); ++i) {
+            order[first_line + i] = inserted[i];
+            lines[inserted[i]].position = static_cast<uint32_t>(first_line + i);
+        }
+    } else {
+        order.erase(order.begin() + first_line, order.begin() + first_line + line_count);
+        order.insert(order.begin() + first_line, inserted.begin(), inserted.end());
+        for (size_t p = first_line; p < order.size(); ++p) lines[order[p]].position = static_cast<uint32_t>(p);
+    }
+    // Satır silindiyse ardından gelen satırın adresi yeniden hesaplanmalı
+    if (inserted.empty() && first_line < order.size()) mark_dirty(order[first_line]);
+
+    update();
+    return reencoded;
+}
+
+int AssemblySession::origin(bool& has_origin) const {
+    for (uint32_t id : order) {
+        if (lines[id].origin >= 0) {
+            has_origin = true;
+            return lines[id].origin;
+        }
+    }
+    has_origin = false;
+    return 0;
+}
+
+std::vector<AssemblyDiagnostic> AssemblySession::diagnostics() const {
+    std::vector<std::pair<uint32_t, const std::vector<AssemblyDiagnostic>*>> by_line;
+    for (const auto& entry : line_messages) by_line.emplace_back(lines[entry.first].position, &entry.second);
+    std::sort(by_line.begin(), by_line.end());
+    std::vector<AssemblyDiagnostic> result;
+    for (const auto& entry : by_line) {
+        for (AssemblyDiagnostic message : *entry.second) {
+            message.line = static_cast<int>(entry.first) + 1;
+            result.push_back(std::move(message));
+        }
+    }
+    return result;
+}
+
+void AssemblySession::program(std::vector<uint8_t>& data, std::vector<AssemblySegment>& segments) const {
+    data.clear();
+    segments.clear();
+    for (uint32_t id : order) {
+        const Line& line = lines[id];
+        if (line.size == 0) continue;
+        if (segments.empty() || segments.back().address + segments.back().length != static_cast<size_t>(line.address)) {
+            segments.push_back(AssemblySegment{static_cast<uint16_t>(line.address), data.size(), 0});
+        }
+        data.insert(data.end(), line.bytes, line.bytes + line.size);
+        segments.back().length += line.size;
+    }
+}
+
+void AssemblySession::listing(AssemblyListing& out) const {
+    out.clear();
+    size_t byte_count = 0;
+    for (uint32_t id : order) {
+        const Line& line = lines[id];
+        LexedLine lexed;
+        const bool lexed_ok = lex_line(line.text, lexed);
+        if (lexed.statement.empty()) continue;
+        const bool has_error = (line.error_count > 0 || !lexed_ok);
+        ListingKind kind = ListingKind::DIRECTIVE;
+        if (line.size > 0) kind = ListingKind::INSTRUCTION;
+        else if (lexed.mnemonic.empty()) kind = ListingKind::LABEL;
+        // Çevrim sayısı opcode'u üreten varyanttan (LDA/STA takma adları parse'taki gibi)
+        int cycles = 0;
+        if (line.size > 0) {
+            std::string_view mnemonic = lexed.mnemonic.text;
+            if (mnemonic == "LDA") mnemonic = "LDAA";
+            else if (mnemonic == "STA") mnemonic = "STAA";
+            for (size_t mode = 0; mode < InstructionSet::MODE_COUNT; ++mode) {
+                const Instruction* instruction = instructionSet.find_instruction(mnemonic, static_cast<AddressingMode>(mode));
+                if (instruction != nullptr && instruction->opcode == line.bytes[0]) { cycles = instruction->cycles; break; }
+            }
+        }
+        const int address = (kind == ListingKind::DIRECTIVE && !has_error) ? lc_after(line) : line.address;
+        if (has_error) kind = ListingKind::ERROR;
+        out.add(static_cast<int>(line.position) + 1, address, -1, byte_count, line.bytes, line.size, cycles, kind,
+                lexed.statement, lexed.label.text);
+        byte_count += line.size;
+    }
+    for_each_symbol([&](std::string_view name, int address) { out.add_symbol(name, address, -1); });
+    std::sort(out.symbols.begin(), out.symbols.end(), [](const ListingSymbol& a, const ListingSymbol& b) {
+        return a.address != b.address ? a.address < b.address : a.name < b.name;
+    });
+    out.diagnostics = diagnostics();
+    out.error_count = errors;
+    out.byte_count = byte_count;
+}
+
+// Etiketin geçerli tanımı: onu tanımlayan satırlardan kaynakta ilk gelen (diğerleri "Duplicate symbol")
+uint32_t AssemblySession::definer(SymbolId id) const {
+    uint32_t best = NO_LINE;
+    for (uint32_t line : symbols[id].definers) {
+        if (best == NO_LINE || lines[line].position < lines[best].position) best = line;
+    }
+    return best;
+}
+
+uint32_t AssemblySession::add_line(std::string_view text) {
+    uint32_t id;
+    if (!free_lines.empty()) {
+        id = free_lines.back();
+        free_lines.pop_back();
+    } else {
+        id = static_cast<uint32_t>(lines.size());
+        lines.emplace_back();
+    }
+    Line& line = lines[id];
+    line = Line();
+    line.text.assign(text);
+    line.alive = true;
+
+    // Bağımlılıklar parse() ile aynı lexer'dan çıkarılır: tanımlanan etiket ve etiket operandı
+    LexedLine lexed;
+    if (lex_line(text, lexed) && !lexed.statement.empty()) {
+        if (!lexed.label.empty()) {
+            line.label = names.intern(lexed.label.text);
+            if (line.label >= symbols.size()) symbols.resize(line.label + 1);
+            symbols[line.label].definers.push_back(id);
+            symbol_changed(line.label);
+        }
+        std::string_view operand = lexed.value_operand.text;
+        if (lexed.register_operand.empty() && !operand.empty()
+            && (isalpha(static_cast<unsigned char>(operand[0])) || operand[0] == '_')) {
+            line.operand = names.intern(operand);
+            if (line.operand >= symbols.size()) symbols.resize(line.operand + 1);
+            symbols[line.operand].users.push_back(id);
+        }
+        // Göreli dallanmanın "$xxxx" hedefi de satırın adresine bağlıdır
+        const Instruction* variant = instructionSet.first_variant(lexed.mnemonic.text);
+        line.relocatable = line.operand == INVALID_SYMBOL
+                        && !(variant != nullptr && variant->addressing_mode == AddressingMode::RELATIVE);
+    }
+    mark_dirty(id);
+    return id;
+}
+
+void AssemblySession::remove_line(uint32_t id) {
+    Line& line = lines[id];
+    line.alive = false;
+    line.dirty = false;
+    line.position = NO_LINE;
+    errors -= line.error_count;
+    line_messages.erase(id);
+    unplace(line); // Altında kalan satırın byte'ları yeniden gönderilebilsin
+    line.operand = INVALID_SYMBOL; // users listesinden gezilirken atılır
+    if (line.label != INVALID_SYMBOL) {
+        std::vector<uint32_t>& definers = symbols[line.label].definers;
+        definers.erase(std::find(definers.begin(), definers.end(), id));
+        SymbolId label = line.label;
+        line.label = INVALID_SYMBOL;
+        symbol_changed(label);
+    }
+    line.text = std::string();
+    free_lines.push_back(id);
+}
+
+// Etiketin tanım kümesi değişti: kullanan satırların "önceden tanımlı mı" kararı ve
+// kalan tanımların "Duplicate symbol" durumu değişebilir, hepsi yeniden kodlanır
+void AssemblySession::symbol_changed(SymbolId id) {
+    for (uint32_t line : symbols[id].definers) mark_dirty(line);
+    for (uint32_t line : live_users(id)) mark_dirty(line);
+}
+
+void AssemblySession::mark_dirty(uint32_t id) {
+    Line& line = lines[id];
+    if (!line.alive || line.dirty) return;
+    line.dirty = true;
+    dirty_lines.push_back(id);
+}
+
+// Etiketi hâlâ kullanan satırlar (her biri bir kez); silinmiş veya operandı değişmiş
+// satırların eskimiş girdileri bu sırada listeden atılır
+std::vector<uint32_t> AssemblySession::live_users(SymbolId id) {
+    std::vector<uint32_t>& users = symbols[id].users;
+    std::vector<uint32_t> result;
+    current_stamp++;
+    size_t kept = 0;
+    for (uint32_t line : users) {
+        Line& user = lines[line];
+        if (!user.alive || user.operand != id || user.stamp == current_stamp) continue;
+        user.stamp = current_stamp;
+        users[kept++] = line;
+        result.push_back(line);
+    }
+    users.resize(kept);
+    return result;
+}
+
+// Kirli satırlar kaynak sırasıyla gezilir. Her kirli satırdan başlayarak adres kaydığı
+// sürece devam edilir; adres tutup satır temiz olduğunda yürüyüş durur (sonrası değişmemiştir).
+// Bir satırın boyu sadece kendinden önceki etiketlere bağlı olduğu için sıra bir kez ilerler.
+void AssemblySession::update() {
+    changed.clear();
+    reencoded = 0;
+    pending.clear();
+    for (uint32_t id : dirty_lines) {
+        if (lines[id].alive && lines[id].dirty) pending.push_back(lines[id].position);
+    }
+    dirty_lines.clear();
+    std::make_heap(pending.begin(), pending.end(), std::greater<uint32_t>());
+
+    while (!pending.empty()) {
+        std::pop_heap(pending.begin(), pending.end(), std::greater<uint32_t>());
+        uint32_t start = pending.back();
+        pending.pop_back();
+        if (start >= order.size() || !lines[order[start]].dirty) continue;
+
+        int lc = (start == 0) ? 0 : lc_after(lines[order[start - 1]]);
+        for (size_t p = start; p < order.size(); ++p) {
+            const Line& line = lines[order[p]];
+            if (!line.dirty && line.address == lc) break;
+            // Sadece kayan ve byte'ları adrese bağlı olmayan satır yeniden derlenmez
+            reencode(order[p], lc, !line.dirty && line.relocatable && line.encoded);
+            lc = lc_after(lines[order[p]]);
+        }
+    }
+    collect_patches();
+}
+
+void AssemblySession::reencode(uint32_t id, int address, bool shift_only) {
+    Line& line = lines[id];
+    const bool moved = !line.encoded || line.address != address;
+    line.address = address;
+    if (shift_only) changed.push_back(id);
+    else encode(id);
+    if (!moved || line.label == INVALID_SYMBOL || definer(line.label) != id) return;
+
+    // Etiket taşındı: sonraki kullanıcılar (geri başvuru, boyları değişebilir) sıraya girer,
+    // önceki kullanıcılar (ileri başvuru, boyu sabit EXTENDED/RELATIVE) hemen yeniden kodlanır
+    for (uint32_t user_id : live_users(line.label)) {
+        if (user_id == id) continue;
+        Line& user = lines[user_id];
+        if (user.position > line.position) {
+            if (!user.dirty) {
+                user.dirty = true;
+                pending.push_back(user.position);
+                std::push_heap(pending.begin(), pending.end(), std::greater<uint32_t>());
+            }
+        } else if (!user.dirty) {
+            encode(user_id);
+        }
+    }
+}
+
+// Satırı tek satırlık bir bağlamda parse() ile derler. Bağlam, satırın gördüğü sembol
+// durumuyla kurulur: kendinden önce tanımlı etiketler önceden tanımlanır, sonra tanımlananlar
+// parse'tan sonra patch_forward_references ile yamalanır (tek geçişli derlemeyle aynı sonuç).
+void AssemblySession::encode(uint32_t id) {
+    Line& line = lines[id];
+    scratch.reset();
+    scratch.LC = line.address;
+
+    auto predefine = [&](SymbolId symbol, int address) {
+        scratch.symbolTable.define(scratch.symbolTable.intern(names.name(symbol)), address);
+    };
+    if (line.label != INVALID_SYMBOL) {
+        uint32_t label_definer = definer(line.label);
+        if (label_definer != id) predefine(line.label, lines[label_definer].address); // parse "Duplicate symbol" der
+    }
+    uint32_t operand_definer = NO_LINE;
+    if (line.operand != INVALID_SYMBOL && line.operand != line.label) {
+        operand_definer = definer(line.operand);
+        if (operand_definer != NO_LINE && lines[operand_definer].position < line.position) {
+            predefine(line.operand, lines[operand_definer].address);
+        }
+    }
+
+    parse(scratch, line.text, static_cast<int>(line.position) + 1);
+
+    if (operand_definer != NO_LINE && lines[operand_definer].position > line.position) {
+        SymbolId symbol = scratch.symbolTable.intern(names.name(line.operand));
+        int address = lines[operand_definer].address;
+        scratch.symbolTable.define(symbol, address);
+        patch_forward_references(scratch, symbol, address);
+    }
+    finish_assembly(scratch);
+    if (scratch.is_relocatable()) { // Satırlar tek tek derlendiği için bölüm durumu taşınamaz
+        scratch.error_count++;
+        scratch.messages.push_back(AssemblyDiagnostic{static_cast<int>(line.position) + 1, 0, true,
+                                                      "SECTION/XDEF/XREF are not supported in an editor session"});
+    }
+
+    line.size = static_cast<uint8_t>(std::min(scratch.programData.size(), MAX_LINE_BYTES));
+    std::copy(scratch.programData.begin(), scratch.programData.begin() + line.size, line.bytes);
+    line.origin = scratch.has_origin ? scratch.LC : -1;
+    line.advance = scratch.has_origin ? 0 : scratch.LC - line.address;
+    errors += scratch.error_count - line.error_count;
+    line.error_count = scratch.error_count;
+    if (scratch.messages.empty()) line_messages.erase(id);
+    else line_messages[id] = scratch.messages;
+    line.dirty = false;
+    line.encoded = true;
+    changed.push_back(id);
+    reencoded++;
+}
+
+// Satırın son gönderilen aralığı cover'dan düşülür; başka satırın da kapladığı adresler
+// sahibi değişebileceği için contested'a girer
+void AssemblySession::unplace(Line& line) {
+    for (size_t i = 0; i < line.placed_size; ++i) {
+        uint16_t address = static_cast<uint16_t>(line.placed_address + i);
+        if (--cover[address] > 0) contested.push_back(address);
+    }
+    line.placed_size = 0;
+}
+
+void AssemblySession::place(Line& line) {
+    line.placed_address = line.address;
+    line.placed_size = line.size;
+    for (size_t i = 0; i < line.size; ++i) {
+        uint16_t address = static_cast<uint16_t>(line.address + i);
+        if (++cover[address] > 1) contested.push_back(address);
+    }
+}
+
+// Yeniden kodlanan satırların byte'ları adres başına bir kez sahnelenir ve son gönderilen
+// görüntüyle karşılaştırılır; sadece farklı olanlar adrese göre sıralanıp ardışık aralıklar
+// halinde yama listesine girer. Boşalan adresler (silinen veya kısalan satırlar) değiştirilmez.
+// Çakışan ORG bölgelerinde assemble_buffer çıktısının yüklenmesindeki gibi kaynakta sonra gelen
+// satır kazanır. Çakışma kalkınca (satır taşındı/silindi) altta kalan satırın byte'ları da
+// yeniden gönderilir; bunun için çakışmaya karışan adreslerin sahibi bütün satırlar gezilerek bulunur.
+void AssemblySession::collect_patches() {
+    patch_list.clear();
+    patch_data.clear();
+    staged_addresses.clear();
+    current_stamp++;
+    auto stage = [&](uint16_t address, uint8_t value) {
+        if (staged_stamp[address] != current_stamp) {
+            staged_stamp[address] = current_stamp;
+            staged_addresses.push_back(address);
+        }
+        staged[address] = value;
+    };
+    for (uint32_t id : changed) {
+        Line& line = lines[id];
+        if (!line.alive) continue;
+        unplace(line);
+        place(line);
+        for (size_t i = 0; i < line.size; ++i) stage(static_cast<uint16_t>(line.address + i), line.bytes[i]);
+    }
+    if (!contested.empty()) {
+        for (uint16_t address : contested) contested_flag[address] = 1;
+        for (uint32_t id : order) {
+            const Line& line = lines[id];
+            for (size_t i = 0; i < line.size; ++i) {
+                uint16_t address = static_cast<uint16_t>(line.address + i);
+                if (contested_flag[address]) stage(address, line.bytes[i]); // Sonraki satır üzerine yazar
+            }
+        }
+        for (uint16_t address : contested) contested_flag[address] = 0;
+        contested.clear();
+    }
+    std::sort(staged_addresses.begin(), staged_addresses.end());
+    for (uint16_t address : staged_addresses) {
+        uint8_t value = staged[address];
+        if (written[address] && image[address] == value) continue;
+        if (!patch_list.empty() && patch_list.back().address + patch_list.back().length == address) {
+            patch_list.back().length++;
+        } else {
+            patch_list.push_back(MemoryPatch{address, patch_data.size(), 1});
+        }
+        patch_data.push_back(value);
+        image[address] = value;
+        written[address] = 1;
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef ASSEMBLY_SESSION_HPP
+#define ASSEMBLY_SESSION_HPP
+
+#include "assembler.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Emülatör belleğine doğrudan yazılacak değişiklik: patch_bytes()[offset, offset+length) -> address
+struct MemoryPatch {
+    uint16_t address;
+    size_t offset;
+    size_t length;
+};
+
+// Editör için artımlı derleme oturumu. Her satırın adresi, byte'ları, tanımladığı etiket ve
+// operandında kullandığı etiket saklanır. edit() sonrası sadece değişen satırlar ile adresi
+// kayan veya kullandığı etiketi taşınan satırlar yeniden kodlanır; sonuç, önceki görüntüye
+// göre değişen byte'ları tutan bir yama listesidir.
+//
+// Çıktı tek geçişli assemble_buffer ile aynıdır (ileri başvurular EXTENDED, geri başvurular
+// $FF'e sığıyorsa DIRECT). Satır boyu sadece kendisinden önceki etiketlere bağlı olduğu için
+// satırlar kaynak sırasıyla bir kez gezilerek yeniden hesaplanır.
+class AssemblySession
+{
+public:
+    explicit AssemblySession(const InstructionSet& set);
+
+    // [first_line, first_line + line_count) satırlarını (0'dan başlar) text'teki satırlarla
+    // değiştirir ve yeniden derler. text assemble_buffer gibi '\n' ile bölünür ("" hiç satır
+    // eklemez, "\n" bir boş satır ekler). Yeniden kodlanan satır sayısını döndürür.
+    size_t edit(size_t first_line, size_t line_count, std::string_view text);
+    // Tüm kaynağı değiştirir; ilk çağrıda yama listesi programın tamamıdır
+    size_t load(std::string_view source) { return edit(0, line_count(), source); }
+
+    // Son edit()'in yamaları (adrese göre sıralı, ardışık byte'lar birleştirilmiş)
+    const std::vector<MemoryPatch>& patches() const { return patch_list; }
+    const std::vector<uint8_t>& patch_bytes() const { return patch_data; }
+
+    size_t line_count() const { return order.size(); }
+    int error_count() const { return errors; }
+    // İlk geçerli ORG; yoksa has_origin false döner
+    int origin(bool& has_origin) const;
+    // Satır numarasına göre sıralı tüm mesajlar
+    std::vector<AssemblyDiagnostic> diagnostics() const;
+    // Tanımlı her etiket için fn(isim, adres)
+    template <typename Fn>
+    void for_each_symbol(Fn fn) const
+    {
+        for (SymbolId id = 0; id < symbols.size(); ++id)
+        {
+            uint32_t line = definer(id);
+            if (line != NO_LINE) fn(names.name(id), lines[line].address);
+        }
+    }
+    // Programın tamamı, assemble_buffer'ın programData ve segments çıktısıyla aynı düzende
+    void program(std::vector<uint8_t>& data, std::vector<AssemblySegment>& segments) const;
+    // Yapılandırılmış listeleme (listing.hpp); satırlar istek anında yeniden parçalanır
+    void listing(AssemblyListing& out) const;
+
+private:
+    static constexpr uint32_t NO_LINE = UINT32_MAX;
+    static constexpr size_t MAX_LINE_BYTES = 4; // M6800 komutu en fazla 3 byte
+
+    struct Line {
+        std::string text;
+        uint32_t position = NO_LINE;       // order içindeki sıra (silinmişse NO_LINE)
+        int address = 0;                   // Satır başındaki LC
+        int advance = 0;                   // ORG değilse sonraki satıra kadar LC artışı
+        int origin = -1;                   // Geçerli ORG satırıysa yeni LC
+        uint8_t size = 0;
+        uint8_t bytes[MAX_LINE_BYTES] = {};
+        int placed_address = 0;            // Son gönderilen görüntüde kapladığı aralık (cover'da sayılı)
+        uint8_t placed_size = 0;
+        SymbolId label = INVALID_SYMBOL;   // Tanımladığı etiket
+        SymbolId operand = INVALID_SYMBOL; // Operandında kullandığı etiket
+        bool relocatable = false;          // Byte'ları adrese bağlı değil (etiket/göreli operand yok)
+        bool alive = false;                // false: silinmiş, id boşta
+        bool dirty = false;
+        bool encoded = false;
+        int error_count = 0;
+        uint32_t stamp = 0;                // Tekrarlanan ziyaretleri elemek için
+    };
+
+    struct Symbol {
+        std::vector<uint32_t> definers;    // Etiketi tanımlayan satırlar (ilk sıradaki geçerlidir)
+        std::vector<uint32_t> users;       // Operandında kullanan satırlar (eskimiş girdiler gezilirken atılır)
+    };
+
+    uint32_t definer(SymbolId id) const;
+    int lc_after(const Line& line) const { return line.origin >= 0 ? line.origin : line.address + line.advance; }
+    uint32_t add_line(std::string_view text);
+    void remove_line(uint32_t id);
+    void symbol_changed(SymbolId id);
+    void mark_dirty(uint32_t id);
+    std::vector<uint32_t> live_users(SymbolId id);
+    void update();
+    void reencode(uint32_t id, int address, bool shift_only);
+    void encode(uint32_t id);
+    void collect_patches();
+    void place(Line& line);
+    void unplace(Line& line);
+
+    const InstructionSet& instructionSet;
+    std::ostream null_stream{nullptr};   // Satır derlemesinin mesajları messages'ta toplanır
+    AssemblyContext scratch;             // Tek satırlık derleme bağlamı (her satırda temizlenir)
+
+    std::vector<Line> lines;             // Satır numarası (id) ile; id'ler silinince yeniden kullanılır
+    std::vector<uint32_t> free_lines;
+    std::vector<uint32_t> order;         // Kaynak sırası -> id
+    std::unordered_map<uint32_t, std::vector<AssemblyDiagnostic>> line_messages; // id -> mesajlar (sadece mesajı olan satırlar)
+    StringInterner names;
+    std::vector<Symbol> symbols;
+    int errors = 0;
+    uint32_t current_stamp = 0;
+
+    std::vector<uint32_t> dirty_lines;   // edit() içinde değişen satırlar (id)
+    std::vector<uint32_t> pending;       // update() içinde yeniden kodlanacak satırların sıraları (min-heap)
+    std::vector<uint32_t> changed;       // Bu edit()'te yeniden kodlanan satırlar
+    size_t reencoded = 0;
+
+    std::vector<uint8_t> image;          // Emülatöre en son gönderilen bellek görüntüsü
+    std::vector<uint8_t> written;        // image'daki adres hiç yazıldı mı
+    std::vector<uint8_t> staged;         // collect_patches: adrese yazılacak yeni byte
+    std::vector<uint32_t> staged_stamp;  // collect_patches: staged[adres] bu turda yazıldı mı
+    std::vector<uint16_t> staged_addresses;
+    std::vector<uint32_t> cover;         // Adresi kaplayan canlı satır sayısı (placed aralıklarına göre)
+    std::vector<uint16_t> contested;     // Birden çok satırın kapladığı veya kaplayanı değişen adresler
+    std::vector<uint8_t> contested_flag;
+    std::vector<MemoryPatch> patch_list;
+    std::vector<uint8_t> patch_data;
+};
+
+#endif // ASSEMBLY_SESSION_HPP
@@ -0,0 +1,501 @@
+// Toplu derleme ve çalıştırma aracı.
+//
+// Kullanım: batch_runner <manifest.txt> <rapor.txt> [--threads=N] [--profile[=N]] [--callgraph]
+// Derleme: g++ -std=c++17 -O2 -pthread batch_runner.cpp assembler.cpp lexer.cpp listing.cpp source_file.cpp emulator.cpp profiler.cpp breakpoints.cpp memory_bus.cpp devices.cpp event_queue.cpp set_initializer.cpp trace.cpp -o batch_runner
+//
+// Manifest dosyasında her satır bir programdır; boş satırlar ve ';' ya da '#' ile
+// başlayan satırlar atlanır. İlk sütun kaynak dosyasıdır (manifest'in bulunduğu
+// klasöre göre), ardından boşlukla ayrılmış beklentiler gelir:
+//
+//   example.asm  cycles=1000  A=$00  $0200=$0E  $0051=$0F
+//
+//   cycles=N     En fazla N çevrim çalıştırılır (varsayılan 1000000). Program bu
+//                sınıra kadar SWI ile durmazsa test başarısız sayılır.
+//   A= B= X= SP= PC= CCR=   Program durduğundaki yazmaç değerleri
+//   $adres=$dd   Bellekteki byte; $dddd yazılırsa adresten başlayan 16-bit word
+//   uart=$F000  timer=$F010  pia=$F020   Verilen taban adresine hazır cihaz takar.
+//                UART'ın gönderdiği byte'lar rapora program satırının altına yazılır.
+//   rom=$E000-$FFFF   Aralığa değen sayfalar ROM olur (program yine yüklenir, CPU yazamaz)
+//
+// --profile verilirse programlar profilleyici açık çalıştırılır ve raporda her programın
+// altına en çok çevrim harcayan N etiketi (varsayılan 10) listelenir. --callgraph ayrıca
+// JSR/BSR/RTS/RTI ile çağrı ağacını tutar: rapora alt program başına kapsayıcı/özel çevrim
+// tablosu eklenir ve her kaynağın yanına flame graph araçlarının okuduğu collapsed stack
+// dosyası (kaynak.folded) yazılır.
+//
+// Her program ayrı bir iş parçacığında, kendi AssemblyContext ve Emulator örneğiyle
+// derlenip çalıştırılır. Paylaşılan tek durum salt okunur komut setidir; böylece
+// iş parçacıkları arasında kilit yalnızca iş kuyruklarında bulunur.
+
+#include "assembler.hpp"
+#include "devices.hpp"
+#include "emulator.hpp"
+#include "profiler.hpp"
+#include "set_initializer.hpp"
+#include "source_file.hpp"
+#include "trace.hpp"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t DEFAULT_MAX_CYCLES = 1000000;
+constexpr size_t DEFAULT_PROFILE_LABELS = 10;
+
+enum class ExpectTarget { REG_A, REG_B, REG_X, REG_SP, REG_PC, REG_CCR, MEMORY_BYTE, MEMORY_WORD };
+
+struct Expectation {
+    ExpectTarget target;
+    uint16_t address = 0; // Sadece bellek beklentileri için
+    uint16_t value = 0;
+    std::string text;     // Rapor için manifest'teki yazım
+};
+
+struct ProfileOptions {
+    size_t labels = 0;       // Raporlanan etiket sayısı; 0 ise profilleyici kapalı
+    bool call_graph = false;
+};
+
+struct DeviceMapping {
+    DeviceType type;
+    uint16_t base;
+};
+
+struct BatchJob {
+    std::string source_path;
+    uint64_t max_cycles = DEFAULT_MAX_CYCLES;
+    std::vector<Expectation> expectations;
+    std::vector<DeviceMapping> devices;
+    std::vector<std::pair<uint16_t, uint32_t>> rom_ranges; // (başlangıç, uzunluk)
+};
+
+struct BatchResult {
+    bool passed = false;
+    std::string detail;      // Başarısızlık nedenleri
+    uint64_t cycles = 0;
+    uint64_t steps = 0;
+    StopReason stop_reason = StopReason::MAX_STEPS;
+    double assemble_ms = 0.0;
+    double run_ms = 0.0;
+    std::string profile;     // --profile: etiket düzeyinde sıcak nokta tablosu
+    std::string uart_output; // Takılı UART'ların gönderdiği byte'lar
+};
+
+const char* stop_reason_text(StopReason reason) {
+    switch (reason) {
+        case StopReason::MAX_STEPS: return "MAX_STEPS";
+        case StopReason::SWI: return "SWI";
+        case StopReason::UNKNOWN_OPCODE: return "UNKNOWN_OPCODE";
+        case StopReason::BREAKPOINT: return "BREAKPOINT";
+        case StopReason::PC_OUT_OF_RANGE: return "PC_OUT_OF_RANGE";
+        case StopReason::MAX_CYCLES: return "MAX_CYCLES";
+        case StopReason::HISTORY_EMPTY: return "HISTORY_EMPTY";
+        case StopReason::WATCHPOINT: return "WATCHPOINT";
+        case StopReason::WAITING: return "WAITING";
+    }
+    return "?";
+}
+
+// "$1F", "0x1F" veya ondalık "31" biçimindeki sayıyı okur
+std::optional<uint32_t> parse_number(const std::string& text, int* hex_digits = nullptr) {
+    std::string digits = text;
+    int base = 10;
+    if (!digits.empty() && digits[0] == '$') { digits = digits.substr(1); base = 16; }
+    else if (digits.rfind("0x", 0) == 0 || digits.rfind("0X", 0) == 0) { digits = digits.substr(2); base = 16; }
+    if (digits.empty()) return std::nullopt;
+    try {
+        size_t used = 0;
+        unsigned long value = std::stoul(digits, &used, base);
+        if (used != digits.size() || value > 0xFFFFFFFFul) return std::nullopt;
+        if (hex_digits != nullptr) *hex_digits = (base == 16) ? static_cast<int>(digits.size()) : 0;
+        return static_cast<uint32_t>(value);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+bool parse_expectation(const std::string& token, Expectation& out) {
+    size_t eq = token.find('=');
+    if (eq == std::string::npos || eq == 0) return false;
+    std::string key = token.substr(0, eq);
+    int value_hex_digits = 0;
+    auto value = parse_number(token.substr(eq + 1), &value_hex_digits);
+    if (!value.has_value() || value.value() > 0xFFFF) return false;
+    out.value = static_cast<uint16_t>(value.value());
+    out.text = token;
+
+    for (char& c : key) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    if (key == "A") out.target = ExpectTarget::REG_A;
+    else if (key == "B") out.target = ExpectTarget::REG_B;
+    else if (key == "X") out.target = ExpectTarget::REG_X;
+    else if (key == "SP") out.target = ExpectTarget::REG_SP;
+    else if (key == "PC") out.target = ExpectTarget::REG_PC;
+    else if (key == "CCR") out.target = ExpectTarget::REG_CCR;
+    else {
+        auto address = parse_number(key);
+        if (!address.has_value() || address.value() > 0xFFFF) return false;
+        out.address = static_cast<uint16_t>(address.value());
+        // 2'den fazla hex basamak veya 0xFF'ten büyük değer 16-bit karşılaştırma demektir
+        out.target = (value_hex_digits > 2 || out.value > 0xFF) ? ExpectTarget::MEMORY_WORD : ExpectTarget::MEMORY_BYTE;
+        return true;
+    }
+    if ((out.target == ExpectTarget::REG_A || out.target == ExpectTarget::REG_B || out.target == ExpectTarget::REG_CCR)
+        && out.value > 0xFF) {
+        return false;
+    }
+    return true;
+}
+
+// "uart=$F000", "timer=..", "pia=.." veya "rom=$E000-$FFFF". Bu biçimlerden biri değilse
+// false döner; biçim tutup değer geçersizse valid false olur.
+bool parse_mapping(const std::string& token, BatchJob& job, bool& valid) {
+    static const struct { const char* prefix; DeviceType type; } DEVICE_TOKENS[] = {
+        {"uart=", DeviceType::UART}, {"timer=", DeviceType::TIMER}, {"pia=", DeviceType::PIA}
+    };
+    valid = true;
+    for (const auto& device : DEVICE_TOKENS) {
+        const std::string prefix = device.prefix;
+        if (token.rfind(prefix, 0) != 0) continue;
+        auto base = parse_number(token.substr(prefix.size()));
+        valid = base.has_value() && base.value() <= 0xFFFF;
+        if (valid) job.devices.push_back(DeviceMapping{device.type, static_cast<uint16_t>(base.value())});
+        return true;
+    }
+    if (token.rfind("rom=", 0) != 0) return false;
+    size_t dash = token.find('-', 4);
+    auto first = parse_number(token.substr(4, dash == std::string::npos ? std::string::npos : dash - 4));
+    auto last = (dash == std::string::npos) ? first : parse_number(token.substr(dash + 1));
+    valid = first.has_value() && last.has_value() && first.value() <= last.value() && last.value() <= 0xFFFF;
+    if (valid) job.rom_ranges.emplace_back(static_cast<uint16_t>(first.value()), last.value() - first.value() + 1);
+    return true;
+}
+
+bool load_manifest(const std::string& manifest_path, std::vector<BatchJob>& jobs) {
+    std::ifstream file(manifest_path);
+    if (!file.is_open()) {
+        std::cerr << "Hata: Manifest dosyasi '" << manifest_path << "' acilamadi." << std::endl;
+        return false;
+    }
+    const std::filesystem::path base_dir = std::filesystem::path(manifest_path).parent_path();
+
+    std::string line;
+    int line_number = 0;
+    bool ok = true;
+    while (std::getline(file, line)) {
+        line_number++;
+        line = trim_whitespace(line);
+        if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+
+        std::istringstream tokens(line);
+        std::string source;
+        tokens >> source;
+        BatchJob job;
+        job.source_path = (base_dir / source).string();
+
+        std::string token;
+        while (tokens >> token) {
+            if (token.rfind("cycles=", 0) == 0) {
+                auto limit = parse_number(token.substr(7));
+                if (!limit.has_value() || limit.value() == 0) {
+                    std::cerr << "Hata: Manifest satir " << line_number << ": gecersiz cevrim siniri '" << token << "'" << std::endl;
+                    ok = false;
+                } else {
+                    job.max_cycles = limit.value();
+                }
+                continue;
+            }
+            bool mapping_valid = true;
+            if (parse_mapping(token, job, mapping_valid)) {
+                if (!mapping_valid) {
+                    std::cerr << "Hata: Manifest satir " << line_number << ": gecersiz eslem '" << token << "'" << std::endl;
+                    ok = false;
+                }
+                continue;
+            }
+            Expectation expectation;
+            if (parse_expectation(token, expectation)) {
+                job.expectations.push_back(expectation);
+            } else {
+                std::cerr << "Hata: Manifest satir " << line_number << ": gecersiz beklenti '" << token << "'" << std::endl;
+                ok = false;
+            }
+        }
+        jobs.push_back(std::move(job));
+    }
+    return ok;
+}
+
+std::string hex_value(uint16_t value, int width) {
+    std::ostringstream ss;
+    ss << '$' << std::hex << std::uppercase << std::setw(width) << std::setfill('0') << value;
+    return ss.str();
+}
+
+// Beklentiyi emülatörün son durumuyla karşılaştırır; uymazsa gerçek değeri döndürür
+std::optional<std::string> check_expectation(const Emulator& emu, const Expectation& e) {
+    uint16_t actual = 0;
+    int width = 2;
+    switch (e.target) {
+        case ExpectTarget::REG_A: actual = emu.cpu.accA; break;
+        case ExpectTarget::REG_B: actual = emu.cpu.accB; break;
+        case ExpectTarget::REG_CCR: actual = emu.cpu.ccr; break;
+        case ExpectTarget::REG_X: actual = emu.cpu.ix; width = 4; break;
+        case ExpectTarget::REG_SP: actual = emu.cpu.sp; width = 4; break;
+        case ExpectTarget::REG_PC: actual = emu.cpu.pc; width = 4; break;
+        case ExpectTarget::MEMORY_BYTE: actual = emu.memory[e.address]; break;
+        case ExpectTarget::MEMORY_WORD:
+            actual = static_cast<uint16_t>((emu.memory[e.address] << 8) | emu.memory[static_cast<uint16_t>(e.address + 1)]);
+            width = 4;
+            break;
+    }
+    if (actual == e.value) return std::nullopt;
+    return e.text + " (gercek " + hex_value(actual, width) + ")";
+}
+
+void run_job(const InstructionSet& instruction_set, Emulator& emu, const BatchJob& job, const ProfileOptions& profiling,
+             BatchResult& result) {
+    using clock = std::chrono::steady_clock;
+    std::ostringstream detail;
+
+    auto assemble_start = clock::now();
+    MappedFile source;
+    std::string open_error;
+    if (!source.open(job.source_path, open_error)) {
+        result.detail = "kaynak dosyasi acilamadi: " + open_error;
+        return;
+    }
+    std::ostringstream diagnostics;
+    AssemblyContext ctx(instruction_set, diagnostics);
+    assemble_buffer(ctx, source.text());
+    result.assemble_ms = std::chrono::duration<double, std::milli>(clock::now() - assemble_start).count();
+    if (ctx.error_count > 0) {
+        std::string first_error = diagnostics.str();
+        first_error = first_error.substr(0, first_error.find('\n'));
+        result.detail = std::to_string(ctx.error_count) + " derleme hatasi; ilki: " + first_error;
+        return;
+    }
+
+    auto run_start = clock::now();
+    // Emülatör işler arasında yeniden kullanıldığı için önceki işin eşlemesi temizlenir
+    std::ostringstream uart_output;
+    emu.bus.clear();
+    for (const auto& range : job.rom_ranges) {
+        emu.bus.map(range.first, range.second, PageKind::ROM);
+    }
+    for (const DeviceMapping& mapping : job.devices) {
+        std::unique_ptr<MemoryDevice> device;
+        switch (mapping.type) {
+            case DeviceType::UART: device = std::make_unique<UartDevice>(&uart_output); break;
+            case DeviceType::TIMER: device = std::make_unique<TimerDevice>(); break;
+            case DeviceType::PIA: device = std::make_unique<PiaDevice>(); break;
+        }
+        if (emu.bus.attach(mapping.base, std::move(device)) == nullptr) {
+            result.detail = "cihaz " + hex_value(mapping.base, 4) + " adresine takilamadi (ortusme)";
+            emu.bus.clear();
+            return;
+        }
+    }
+    emu.initialize();
+    for (const AssemblySegment& segment : ctx.segments) {
+        emu.write_memory_range(segment.address, ctx.programData.data() + segment.offset, segment.length);
+    }
+    emu.cpu.pc = static_cast<uint16_t>(ctx.origin);
+    emu.set_profiling(profiling.labels > 0, profiling.call_graph);
+    emu.clear_profile();
+
+    RunConditions conditions;
+    conditions.max_steps = UINT64_MAX;
+    conditions.max_cycles = job.max_cycles;
+    result.stop_reason = emu.run(conditions, result.steps);
+    result.cycles = emu.cpu.cycles;
+    result.run_ms = std::chrono::duration<double, std::milli>(clock::now() - run_start).count();
+    result.uart_output = uart_output.str();
+
+    if (profiling.labels > 0) {
+        std::vector<std::pair<std::string, int>> labels;
+        ctx.symbolTable.for_each_symbol([&](std::string_view name, int address) { labels.emplace_back(name, address); });
+        result.profile = format_profile_report(fold_profile(emu.profile(), labels), profiling.labels);
+        if (profiling.call_graph) {
+            result.profile += format_call_graph_report(fold_call_graph(emu.profile(), labels), profiling.labels);
+            std::filesystem::path folded_path = std::filesystem::path(job.source_path).replace_extension(".folded");
+            std::ofstream folded(folded_path);
+            folded << format_collapsed_stacks(emu.profile(), std::move(labels));
+            if (!folded) result.profile += "collapsed stack dosyasi '" + folded_path.string() + "' yazilamadi\n";
+        }
+    }
+
+    bool passed = (result.stop_reason == StopReason::SWI);
+    if (!passed) {
+        detail << "SWI yerine " << stop_reason_text(result.stop_reason) << " ile durdu (PC " << hex_value(emu.cpu.pc, 4) << ")";
+    }
+    for (const auto& expectation : job.expectations) {
+        if (auto mismatch = check_expectation(emu, expectation)) {
+            if (!detail.str().empty()) detail << "; ";
+            detail << mismatch.value();
+            passed = false;
+        }
+    }
+    result.passed = passed;
+    result.detail = detail.str();
+    emu.bus.clear(); // Takılı UART bu fonksiyonun yerel akışını gösteriyor
+}
+
+// Rapor satırı için yazdırılamayan byte'ları \n, \r, \t veya \xHH olarak kaçırır
+std::string escape_output(const std::string& bytes) {
+    std::ostringstream out;
+    for (unsigned char c : bytes) {
+        if (c == '\n') out << "\\n";
+        else if (c == '\r') out << "\\r";
+        else if (c == '\t') out << "\\t";
+        else if (c == '\\') out << "\\\\";
+        else if (c < 0x20 || c >= 0x7F) out << "\\x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        else out << static_cast<char>(c);
+    }
+    return out.str();
+}
+
+// İş çalan (work-stealing) havuz: her iş parçacığının kendi kuyruğu vardır. İşçi
+// kendi kuyruğunun sonundan alır; kuyruğu boşalınca diğerlerinin başından çalar.
+// Tüm işler baştan bilindiği için yeni iş eklenmez ve bütün kuyruklar boşaldığında
+// işçiler biter.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t worker_count) : queues(worker_count) {}
+
+    // İşler sırayla dağıtılır; komşu (genelde benzer boyutlu) işler farklı işçilere düşer
+    void distribute(size_t job_count) {
+        for (size_t job = 0; job < job_count; ++job) {
+            queues[job % queues.size()].jobs.push_back(job);
+        }
+    }
+
+    bool next_job(size_t worker, size_t& job) {
+        {
+            Queue& own = queues[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = own.jobs.back();
+                own.jobs.pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            Queue& victim = queues[(worker + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t worker_count() const { return queues.size(); }
+
+private:
+    struct alignas(64) Queue { // Her kuyruk ayrı önbellek satırında
+        std::mutex mutex;
+        std::deque<size_t> jobs;
+    };
+    std::vector<Queue> queues;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+    ProfileOptions profiling;
+    bool arguments_ok = (argc >= 3);
+    for (int i = 3; i < argc && arguments_ok; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--threads=", 0) == 0) {
+            auto count = parse_number(arg.substr(10));
+            arguments_ok = count.has_value() && count.value() > 0;
+            if (arguments_ok) thread_count = count.value();
+        } else if (arg == "--profile") {
+            profiling.labels = DEFAULT_PROFILE_LABELS;
+        } else if (arg.rfind("--profile=", 0) == 0) {
+            auto count = parse_number(arg.substr(10));
+            arguments_ok = count.has_value() && count.value() > 0;
+            if (arguments_ok) profiling.labels = count.value();
+        } else if (arg == "--callgraph") {
+            profiling.call_graph = true;
+        } else {
+            arguments_ok = false; // Geçersiz seçenek: kullanım mesajını göster
+        }
+    }
+    if (!arguments_ok) {
+        std::cerr << "Usage: " << argv[0] << " <manifest.txt> <report.txt> [--threads=N] [--profile[=N]] [--callgraph]" << std::endl;
+        return 1;
+    }
+    if (profiling.call_graph && profiling.labels == 0) profiling.labels = DEFAULT_PROFILE_LABELS;
+    // Derleyici listelemesi ve emülatör mesajları kapalı; sonuç sadece rapora yazılır
+    set_trace_level(TraceLevel::OFF);
+
+    std::vector<BatchJob> jobs;
+    if (!load_manifest(argv[1], jobs)) return 1;
+
+    InstructionSet instruction_set;
+    set_initializer(instruction_set);
+
+    std::vector<BatchResult> results(jobs.size());
+    thread_count = std::min(thread_count, std::max<size_t>(1, jobs.size()));
+    WorkStealingPool pool(thread_count);
+    pool.distribute(jobs.size());
+
+    auto wall_start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t worker = 0; worker < pool.worker_count(); ++worker) {
+        workers.emplace_back([&, worker]() {
+            auto emu = std::make_unique<Emulator>(); // İşçi başına bir örnek, işler arasında yeniden kullanılır
+            emu->tracer.set_level(TraceLevel::OFF);
+            size_t job = 0;
+            while (pool.next_job(worker, job)) {
+                run_job(instruction_set, *emu, jobs[job], profiling, results[job]);
+            }
+        });
+    }
+    for (auto& thread : workers) thread.join();
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+
+    std::ofstream report(argv[2]);
+    if (!report.is_open()) {
+        std::cerr << "HATA: Rapor dosyasi '" << argv[2] << "' olusturulamadi!" << std::endl;
+        return 1;
+    }
+    size_t passed = 0;
+    double busy_ms = 0.0;
+    report << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const BatchResult& r = results[i];
+        if (r.passed) passed++;
+        busy_ms += r.assemble_ms + r.run_ms;
+        report << (r.passed ? "PASS " : "FAIL ") << jobs[i].source_path
+               << "  derleme " << r.assemble_ms << " ms  calisma " << r.run_ms << " ms  "
+               << r.cycles << " cevrim  " << r.steps << " komut";
+        if (!r.passed) report << "  -> " << r.detail;
+        report << '\n';
+        if (!r.uart_output.empty()) report << "  UART: \"" << escape_output(r.uart_output) << "\"\n";
+        if (!r.profile.empty()) report << r.profile << '\n';
+    }
+    report << "Toplam " << jobs.size() << ", basarili " << passed << ", basarisiz " << (jobs.size() - passed)
+           << "; " << pool.worker_count() << " is parcacigi, gecen sure " << wall_ms << " ms, toplam is suresi "
+           << busy_ms << " ms\n";
+    report.close();
+
+    std::cout << passed << "/" << jobs.size() << " program basarili (" << wall_ms << " ms). Rapor: " << argv[2] << std::endl;
+    return (passed == jobs.size()) ? 0 : 2;
+}
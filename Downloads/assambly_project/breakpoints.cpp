@@ -0,0 +1,106 @@
+#include "breakpoints.hpp"
+#include <cctype>
+
+namespace {
+
+void skip_spaces(std::string_view text, size_t& pos) {
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+}
+
+// $hex, 0xhex veya ondalık; 16 bite sığmalı
+bool parse_number(std::string_view text, size_t& pos, uint16_t& out) {
+    int base = 10;
+    if (pos < text.size() && text[pos] == '$') {
+        base = 16;
+        pos++;
+    } else if (pos + 1 < text.size() && text[pos] == '0' && (text[pos + 1] == 'x' || text[pos + 1] == 'X')) {
+        base = 16;
+        pos += 2;
+    }
+    uint32_t value = 0;
+    size_t digits = 0;
+    while (pos < text.size()) {
+        int c = std::toupper(static_cast<unsigned char>(text[pos]));
+        int digit = (c >= '0' && c <= '9') ? c - '0' : (base == 16 && c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+        if (digit < 0) break;
+        value = value * base + static_cast<uint32_t>(digit);
+        if (value > 0xFFFF) return false;
+        pos++;
+        digits++;
+    }
+    out = static_cast<uint16_t>(value);
+    return digits > 0;
+}
+
+} // namespace
+
+bool parse_break_condition(std::string_view text, BreakCondition& out, std::string& error) {
+    out = BreakCondition{};
+    size_t pos = 0;
+    skip_spaces(text, pos);
+    if (pos == text.size()) return true; // Koşulsuz
+
+    if (text[pos] == '[') {
+        pos++;
+        skip_spaces(text, pos);
+        if (!parse_number(text, pos, out.address)) {
+            error = "kosulda gecersiz bellek adresi";
+            return false;
+        }
+        skip_spaces(text, pos);
+        if (pos == text.size() || text[pos] != ']') {
+            error = "kosulda ']' eksik";
+            return false;
+        }
+        pos++;
+        out.operand = ConditionOperand::MEMORY;
+    } else {
+        size_t start = pos;
+        while (pos < text.size() && std::isalpha(static_cast<unsigned char>(text[pos]))) pos++;
+        std::string name(text.substr(start, pos - start));
+        for (char& c : name) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        if (name == "A") out.operand = ConditionOperand::REG_A;
+        else if (name == "B") out.operand = ConditionOperand::REG_B;
+        else if (name == "X") out.operand = ConditionOperand::REG_X;
+        else if (name == "SP") out.operand = ConditionOperand::REG_SP;
+        else if (name == "CCR") out.operand = ConditionOperand::REG_CCR;
+        else if (name == "VAL") out.operand = ConditionOperand::VALUE;
+        else {
+            error = "kosulda bilinmeyen sol taraf '" + name + "' (A, B, X, SP, CCR, VAL veya [adres])";
+            return false;
+        }
+    }
+
+    skip_spaces(text, pos);
+    std::string_view rest = text.substr(pos);
+    static const struct { const char* text; ConditionOp op; } OPERATORS[] = {
+        {"==", ConditionOp::EQ}, {"!=", ConditionOp::NE}, {"<=", ConditionOp::LE}, {">=", ConditionOp::GE},
+        {"<", ConditionOp::LT}, {">", ConditionOp::GT}, {"&", ConditionOp::BITS_SET}, {"=", ConditionOp::EQ}
+    };
+    bool found = false;
+    for (const auto& candidate : OPERATORS) {
+        std::string_view op_text(candidate.text);
+        if (rest.substr(0, op_text.size()) == op_text) {
+            out.op = candidate.op;
+            pos += op_text.size();
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        error = "kosulda gecersiz islec (==, !=, <, <=, >, >=, &)";
+        return false;
+    }
+
+    skip_spaces(text, pos);
+    if (!parse_number(text, pos, out.value)) {
+        error = "kosulda gecersiz sayi";
+        return false;
+    }
+    skip_spaces(text, pos);
+    if (pos != text.size()) {
+        error = "kosulun sonunda fazladan metin '" + std::string(text.substr(pos)) + "'";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef BREAKPOINTS_HPP
+#define BREAKPOINTS_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Kesme/izleme noktası türü (DLL üzerinden int olarak geçer, değerleri değiştirmeyin)
+enum class WatchKind : int {
+    EXECUTE = 0,   // PC bu adrese gelince, komut çalışmadan önce durur
+    READ = 1,      // Bir komut bu adresten okuyunca, komut bittikten sonra durur
+    WRITE = 2      // Bir komut bu adrese yazınca, komut bittikten sonra durur
+};
+
+// Koşulun sol tarafı
+enum class ConditionOperand : uint8_t {
+    NONE,      // Koşulsuz
+    REG_A, REG_B, REG_X, REG_SP, REG_CCR,
+    MEMORY,    // [adres] bellekteki byte
+    VALUE      // İzleme noktasında okunan / yazılan byte (kesme noktasında opcode)
+};
+
+enum class ConditionOp : uint8_t { EQ, NE, LT, LE, GT, GE, BITS_SET };
+
+// "A==$05", "X>=$0200", "[$0051]!=0", "VAL&$80" gibi tek bir karşılaştırma. Koşul sadece
+// bitmap'teki bit tuttuğunda değerlendirilir; koşulsuz noktalar için hiç bakılmaz.
+struct BreakCondition {
+    ConditionOperand operand = ConditionOperand::NONE;
+    ConditionOp op = ConditionOp::EQ;
+    uint16_t address = 0;    // MEMORY için
+    uint16_t value = 0;
+};
+
+// Son tetiklenen izleme noktası (arayuz.py'deki ctypes tanımıyla aynı düzen)
+struct WatchHit {
+    uint16_t address;  // Erişilen adres
+    uint16_t pc;       // Erişimi yapan komuttan sonraki PC (çalışmanın durduğu yer)
+    uint8_t value;     // Okunan değer veya yazılan yeni değer
+    uint8_t kind;      // WatchKind
+};
+
+inline bool compare_condition(ConditionOp op, uint16_t left, uint16_t right) {
+    switch (op) {
+        case ConditionOp::EQ: return left == right;
+        case ConditionOp::NE: return left != right;
+        case ConditionOp::LT: return left < right;
+        case ConditionOp::LE: return left <= right;
+        case ConditionOp::GT: return left > right;
+        case ConditionOp::GE: return left >= right;
+        case ConditionOp::BITS_SET: return (left & right) == right;
+    }
+    return false;
+}
+
+// Boş metin koşulsuz demektir. Sol taraf A, B, X, SP, CCR, VAL veya [adres]; işleç ==, !=, <,
+// <=, >, >= veya & (sağdaki bitlerin hepsi 1); sayılar $hex, 0xhex veya ondalık.
+bool parse_break_condition(std::string_view text, BreakCondition& out, std::string& error);
+
+#endif // BREAKPOINTS_HPP
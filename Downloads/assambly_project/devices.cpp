@@ -0,0 +1,224 @@
+#include "devices.hpp"
+#include <algorithm>
+#include <ostream>
+
+// --- UART ---
+
+uint8_t UartDevice::status() const {
+    uint8_t value = STATUS_TDRE;
+    if (!input.empty()) value |= STATUS_RDRF;
+    if ((value & STATUS_RDRF) && (control & CONTROL_RX_IRQ)) value |= STATUS_IRQ;
+    return value;
+}
+
+void UartDevice::update_irq() {
+    set_irq((control & CONTROL_RX_IRQ) && !input.empty());
+}
+
+uint8_t UartDevice::read(uint16_t offset, uint64_t) {
+    if (offset == 0) return status();
+    if (input.empty()) return 0;
+    uint8_t value = input.front();
+    input.pop_front();
+    update_irq();
+    return value;
+}
+
+uint8_t UartDevice::peek(uint16_t offset, uint64_t) const {
+    if (offset == 0) return status();
+    return input.empty() ? 0 : input.front();
+}
+
+void UartDevice::write(uint16_t offset, uint8_t value, uint64_t) {
+    if (offset == 0) {
+        control = ((value & CONTROL_MASTER_RESET) == CONTROL_MASTER_RESET) ? 0 : value;
+        update_irq();
+        return;
+    }
+    transmitted.push_back(static_cast<char>(value));
+    if (host != nullptr) host->put(static_cast<char>(value));
+}
+
+void UartDevice::feed_input(const uint8_t* bytes, size_t length) {
+    input.insert(input.end(), bytes, bytes + length);
+    update_irq();
+}
+
+std::string UartDevice::take_output(size_t max_bytes) {
+    std::string out = transmitted.substr(0, max_bytes);
+    transmitted.erase(0, out.size());
+    return out;
+}
+
+// --- Zamanlayıcı ---
+
+uint64_t TimerDevice::expirations(uint64_t cycles) const {
+    if (!(control & CONTROL_START) || cycles < start_cycle) return 0;
+    uint64_t count = (cycles - start_cycle) / period();
+    return (control & CONTROL_ONE_SHOT) ? std::min<uint64_t>(count, 1) : count;
+}
+
+bool TimerDevice::expired(uint64_t cycles) const {
+    return expired_carry || expirations(cycles) > acknowledged;
+}
+
+uint16_t TimerDevice::count(uint64_t cycles) const {
+    if (!(control & CONTROL_START)) return stopped_count;
+    if ((control & CONTROL_ONE_SHOT) && expirations(cycles) > 0) return 0;
+    uint64_t elapsed = (cycles >= start_cycle) ? cycles - start_cycle : 0;
+    return static_cast<uint16_t>(period() - elapsed % period()); // 65536 -> 0
+}
+
+void TimerDevice::restart(uint64_t cycles) {
+    expired_carry = expired(cycles);
+    start_cycle = cycles;
+    acknowledged = 0;
+}
+
+uint8_t TimerDevice::status(uint64_t cycles) const {
+    uint8_t value = 0;
+    if (expired(cycles)) {
+        value |= STATUS_EXPIRED;
+        if (control & CONTROL_IRQ) value |= STATUS_IRQ;
+    }
+    return value;
+}
+
+void TimerDevice::update_irq(uint64_t cycles) {
+    cancel();
+    const bool flagged = expired(cycles);
+    set_irq((control & CONTROL_IRQ) && flagged);
+    // Bayrak kuruluyken sonraki dolmalar hattı değiştirmez; olay sadece bayrağı kuracak dolma için
+    const uint64_t next = acknowledged + 1;
+    if ((control & CONTROL_START) && (control & CONTROL_IRQ) && !flagged
+        && !((control & CONTROL_ONE_SHOT) && next > 1)) {
+        schedule(start_cycle + next * period());
+    }
+}
+
+void TimerDevice::on_event(uint64_t when, uint32_t) {
+    update_irq(when);
+}
+
+uint8_t TimerDevice::read(uint16_t offset, uint64_t cycles) {
+    if (offset == 4) {
+        uint16_t value = count(cycles);
+        count_low_latch = static_cast<uint8_t>(value & 0xFF);
+        return static_cast<uint8_t>(value >> 8);
+    }
+    if (offset == 5) return count_low_latch;
+    return peek(offset, cycles);
+}
+
+uint8_t TimerDevice::peek(uint16_t offset, uint64_t cycles) const {
+    switch (offset) {
+        case 0: return control;
+        case 1: return status(cycles);
+        case 2: return static_cast<uint8_t>(latch >> 8);
+        case 3: return static_cast<uint8_t>(latch & 0xFF);
+        case 4: return static_cast<uint8_t>(count(cycles) >> 8);
+        case 5: return static_cast<uint8_t>(count(cycles) & 0xFF);
+    }
+    return 0xFF;
+}
+
+void TimerDevice::write(uint16_t offset, uint8_t value, uint64_t cycles) {
+    switch (offset) {
+        case 0: {
+            const bool was_running = (control & CONTROL_START) != 0;
+            const bool running = (value & CONTROL_START) != 0;
+            if (was_running && !running) {
+                // Durdurulurken sayaç ve bayrak dondurulur
+                expired_carry = expired(cycles);
+                stopped_count = count(cycles);
+                acknowledged = 0;
+            }
+            control = value & (CONTROL_START | CONTROL_IRQ | CONTROL_ONE_SHOT);
+            if (!was_running && running) restart(cycles);
+            break;
+        }
+        case 1:
+            expired_carry = false;
+            acknowledged = expirations(cycles);
+            break;
+        case 2:
+            latch = static_cast<uint16_t>((latch & 0x00FF) | (value << 8));
+            break;
+        case 3:
+            latch = static_cast<uint16_t>((latch & 0xFF00) | value);
+            stopped_count = latch;
+            if (control & CONTROL_START) restart(cycles);
+            break;
+        default:
+            return; // Sayaç salt okunur
+    }
+    update_irq(cycles);
+}
+
+void TimerDevice::reset() {
+    control = 0;
+    latch = 0;
+    start_cycle = 0;
+    acknowledged = 0;
+    expired_carry = false;
+    stopped_count = 0;
+    count_low_latch = 0;
+    update_irq(0);
+}
+
+// --- PIA ---
+
+uint8_t PiaDevice::read(uint16_t offset, uint64_t cycles) {
+    Port& port = ports[(offset >> 1) & 1];
+    if ((offset & 1) == 0 && (port.control & CONTROL_DATA_SELECT)) {
+        port.control &= static_cast<uint8_t>(~CONTROL_LINE_FLAG); // Veri okuması bayrağı temizler
+        update_irq();
+        return read_data(port);
+    }
+    return peek(offset, cycles);
+}
+
+uint8_t PiaDevice::peek(uint16_t offset, uint64_t) const {
+    const Port& port = ports[(offset >> 1) & 1];
+    if (offset & 1) return port.control;
+    return (port.control & CONTROL_DATA_SELECT) ? read_data(port) : port.ddr;
+}
+
+void PiaDevice::write(uint16_t offset, uint8_t value, uint64_t) {
+    Port& port = ports[(offset >> 1) & 1];
+    if (offset & 1) {
+        port.control = static_cast<uint8_t>((port.control & CONTROL_LINE_FLAG) | (value & 0x3F));
+        update_irq();
+    } else if (port.control & CONTROL_DATA_SELECT) {
+        port.output = value;
+    } else {
+        port.ddr = value;
+    }
+}
+
+void PiaDevice::set_control_line(int port_index, bool level) {
+    Port& port = ports[port_index & 1];
+    const bool rising = (port.control & CONTROL_RISING_EDGE) != 0;
+    if (level != port.line && level == rising) {
+        port.control |= CONTROL_LINE_FLAG;
+    }
+    port.line = level;
+    update_irq();
+}
+
+void PiaDevice::reset() {
+    for (Port& port : ports) {
+        const uint8_t input = port.input; // Host'un verdiği giriş korunur
+        port = Port{};
+        port.input = input;
+    }
+    update_irq();
+}
+
+void PiaDevice::update_irq() {
+    bool active = false;
+    for (const Port& port : ports) {
+        if ((port.control & CONTROL_LINE_FLAG) && (port.control & CONTROL_LINE_IRQ)) active = true;
+    }
+    set_irq(active);
+}
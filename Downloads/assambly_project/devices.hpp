@@ -0,0 +1,144 @@
+#ifndef DEVICES_HPP
+#define DEVICES_HPP
+
+#include "memory_bus.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <string>
+
+// Hazır cihaz modelleri. Hepsi MemoryBus::attach ile bir taban adresine takılır.
+// Tür numaraları DLL üzerinden int olarak geçer, değerleri değiştirmeyin.
+enum class DeviceType : int {
+    UART = 0,
+    TIMER = 1,
+    PIA = 2
+};
+
+// MC6850 ACIA benzeri seri port (2 yazmaç).
+//   +0 okuma: durum (bit 0 RDRF alınan veri hazır, bit 1 TDRE gönderim boş, bit 7 IRQ)
+//   +0 yazma: kontrol (bit 0-1 = 11 master reset, bit 7 alma kesmesi izni)
+//   +1 okuma: alınan byte (kuyruktan çıkar), yazma: gönderilecek byte
+// Gönderim anında tamamlanır, bu yüzden TDRE hep 1'dir. Gönderilen byte'lar verilmişse host
+// akışına yazılır ve ayrıca output tamponunda birikir; alınacak byte'lar feed_input ile verilir.
+// Alma kesmesi açıkken kuyrukta byte olduğu sürece IRQ hattı etkindir.
+class UartDevice : public MemoryDevice {
+public:
+    static constexpr uint8_t STATUS_RDRF = 0x01;
+    static constexpr uint8_t STATUS_TDRE = 0x02;
+    static constexpr uint8_t STATUS_IRQ = 0x80;
+    static constexpr uint8_t CONTROL_MASTER_RESET = 0x03;
+    static constexpr uint8_t CONTROL_RX_IRQ = 0x80;
+
+    explicit UartDevice(std::ostream* host = nullptr) : host(host) {}
+
+    const char* name() const override { return "UART"; }
+    uint16_t size() const override { return 2; }
+    uint8_t read(uint16_t offset, uint64_t cycles) override;
+    void write(uint16_t offset, uint8_t value, uint64_t cycles) override;
+    uint8_t peek(uint16_t offset, uint64_t cycles) const override;
+    void reset() override { control = 0; update_irq(); } // Host tarafındaki kuyruk ve tampon korunur
+
+    void feed_input(const uint8_t* bytes, size_t length);
+    // Gönderilen ve henüz alınmamış byte'lardan en eski max_bytes tanesini döndürür ve tampondan çıkarır
+    std::string take_output(size_t max_bytes = std::string::npos);
+    size_t pending_input() const { return input.size(); }
+
+private:
+    uint8_t status() const;
+    void update_irq();
+
+    std::ostream* host;
+    std::deque<uint8_t> input;
+    std::string transmitted;
+    uint8_t control = 0;
+};
+
+// Programlanabilir aralık zamanlayıcısı (6 yazmaç). Sayaç CPU çevrimiyle azalır; değeri
+// her çevrimde güncellenmez, okunduğunda başlangıç çevriminden hesaplanır.
+//   +0 kontrol: bit 0 START, bit 1 IRQ izni, bit 2 ONE_SHOT (0: süre dolunca yeniden yüklenir)
+//   +1 okuma: durum (bit 0 süre doldu, bit 7 IRQ); yazma: süre doldu bayrağını temizler
+//   +2/+3 yükleme değeri yüksek/düşük byte (çevrim; 0 = 65536). Düşük byte'ı yazmak sayacı
+//         yeniden başlatır.
+//   +4/+5 sayaç yüksek/düşük byte (salt okunur). Yüksek byte okunurken düşük byte tutulur,
+//         böylece iki okuma arasında sayacın ilerlemesi değeri bozmaz.
+// IRQ izni açıkken süre doldu bayrağı IRQ hattını sürer. Bayrağın kurulacağı çevrim olay
+// kuyruğuna konur; sayaç yine her çevrimde güncellenmez.
+class TimerDevice : public MemoryDevice {
+public:
+    static constexpr uint8_t CONTROL_START = 0x01;
+    static constexpr uint8_t CONTROL_IRQ = 0x02;
+    static constexpr uint8_t CONTROL_ONE_SHOT = 0x04;
+    static constexpr uint8_t STATUS_EXPIRED = 0x01;
+    static constexpr uint8_t STATUS_IRQ = 0x80;
+
+    const char* name() const override { return "TIMER"; }
+    uint16_t size() const override { return 6; }
+    uint8_t read(uint16_t offset, uint64_t cycles) override;
+    void write(uint16_t offset, uint8_t value, uint64_t cycles) override;
+    uint8_t peek(uint16_t offset, uint64_t cycles) const override;
+    void reset() override;
+    void on_event(uint64_t when, uint32_t tag) override;
+
+    bool expired(uint64_t cycles) const;
+    uint16_t count(uint64_t cycles) const;
+
+private:
+    uint32_t period() const { return latch == 0 ? 0x10000u : latch; }
+    uint64_t expirations(uint64_t cycles) const; // Başlatıldığından beri dolma sayısı
+    void restart(uint64_t cycles);
+    uint8_t status(uint64_t cycles) const;
+    // IRQ hattını günceller ve bayrak henüz kurulu değilse bir sonraki dolmayı zamanlar
+    void update_irq(uint64_t cycles);
+
+    uint8_t control = 0;
+    uint16_t latch = 0;
+    uint64_t start_cycle = 0;
+    uint64_t acknowledged = 0;     // Temizlenmiş dolma sayısı
+    bool expired_carry = false;    // Yeniden başlatma/durdurma öncesinden kalan bayrak
+    uint16_t stopped_count = 0;    // Dururken okunan sayaç
+    uint8_t count_low_latch = 0;
+};
+
+// MC6821 PIA benzeri iki adet 8-bit paralel port (4 yazmaç).
+//   +0 / +2 A / B portu: kontrol yazmacının bit 2'si 0 ise yön (DDR, 1 = çıkış), 1 ise veri
+//   +1 / +3 A / B kontrol: bit 0 CA1/CB1 kesme izni, bit 1 etkin kenar (0 düşen, 1 yükselen),
+//                          bit 2 DDR/veri seçimi, bit 7 kenar geldi bayrağı (salt okunur,
+//                          veri yazmacı okununca temizlenir)
+// Veri okuması çıkış bitlerinde son yazılanı, giriş bitlerinde host'un verdiği değeri döndürür.
+// Kesme izni açık bir portta kenar bayrağı kuruluyken IRQ hattı etkindir.
+class PiaDevice : public MemoryDevice {
+public:
+    static constexpr uint8_t CONTROL_LINE_IRQ = 0x01;
+    static constexpr uint8_t CONTROL_RISING_EDGE = 0x02;
+    static constexpr uint8_t CONTROL_DATA_SELECT = 0x04;
+    static constexpr uint8_t CONTROL_LINE_FLAG = 0x80;
+
+    const char* name() const override { return "PIA"; }
+    uint16_t size() const override { return 4; }
+    uint8_t read(uint16_t offset, uint64_t cycles) override;
+    void write(uint16_t offset, uint8_t value, uint64_t cycles) override;
+    uint8_t peek(uint16_t offset, uint64_t cycles) const override;
+    void reset() override;
+
+    // Host tarafı: port 0 = A, 1 = B
+    void set_input(int port, uint8_t value) { ports[port & 1].input = value; }
+    uint8_t output(int port) const { const Port& p = ports[port & 1]; return p.output & p.ddr; }
+    void set_control_line(int port, bool level);
+
+private:
+    struct Port {
+        uint8_t output = 0;
+        uint8_t ddr = 0;
+        uint8_t control = 0;
+        uint8_t input = 0xFF;   // Bağlı olmayan girişler 1 okunur
+        bool line = false;
+    };
+    uint8_t read_data(const Port& port) const { return (port.output & port.ddr) | (port.input & ~port.ddr); }
+    void update_irq();
+
+    Port ports[2];
+};
+
+#endif // DEVICES_HPP
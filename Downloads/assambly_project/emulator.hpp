@@ -4,7 +4,17 @@
 #include <vector>
 #include <cstdint> // uint8_t, uint16_t için
 #include <string>
+#include <array>
+#include <bitset>
+#include <deque>
+#include <memory>
 #include "main.hpp" // InstructionSet ve AddressingMode gibi tanımlar için
+#include "trace.hpp"
+#include "profiler.hpp"
+#include "breakpoints.hpp"
+#include "memory_bus.hpp"
+#include "event_queue.hpp"
+#include <unordered_map>
 
 // CPU Yazmaçları ve Durum Bayrakları
 struct CPUState {
@@ -19,6 +29,8 @@ struct CPUState {
     // CCR'nin 7. ve 6. bitleri her zaman 1'dir.
     uint8_t ccr; // Durum Kodu Yazmacı (8-bit)
 
+    uint64_t cycles; // Reset'ten beri geçen toplam saat çevrimi
+
     // CCR bayraklarına erişim için yardımcı fonksiyonlar
     bool get_H_flag() const { return (ccr >> 5) & 1; }
     bool get_I_flag() const { return (ccr >> 4) & 1; }
@@ -34,30 +46,294 @@ struct CPUState {
     void set_V_flag(bool val) { if (val) ccr |= (1 << 1); else ccr &= ~(1 << 1); }
     void set_C_flag(bool val) { if (val) ccr |= 1; else ccr &= ~1; }
 
-    CPUState() : pc(0), sp(0), ix(0), accA(0), accB(0), ccr(0xC0) { // CCR'nin 7. ve 6. bitleri her zaman 1 (0xC0)
+    CPUState() : pc(0), sp(0), ix(0), accA(0), accB(0), ccr(0xC0), cycles(0) { // CCR'nin 7. ve 6. bitleri her zaman 1 (0xC0)
         set_I_flag(true); // Kesmeler başlangıçta maskeli
         set_Z_flag(true); // Genellikle başlangıçta Zero flag set edilir (sonuç 0 gibi)
     } 
 };
 
-// Global CPU durumu ve Bellek (emulator.cpp içinde tanımlanacak)
-extern CPUState cpu;
-extern std::vector<uint8_t> memory; // 64KB (65536 byte)
+class Emulator;
+
+// Komut işleyicisi. Operand komut byte'larından önceden çözülmüş olarak verilir:
+// IMM'de değerin kendisi, DIR/EXT'de adres, IDX'te X'e eklenecek ofset, REL'de
+// 8-bit işaretli ofset. Çağrı anında PC zaten bir sonraki komutu gösterir.
+using OpcodeHandler = void (*)(Emulator&, uint16_t operand);
+
+// Opcode çözümleme tablosu girdisi (emulator.cpp'de derleme zamanında kurulur)
+struct OpcodeEntry {
+    OpcodeHandler handler;  // Komutu yürüten işleyici
+    const char* mnemonic;   // "???" ise opcode tanımsızdır
+    AddressingMode mode;
+    uint8_t no_of_bytes;    // Opcode dahil toplam uzunluk
+    uint8_t cycles;         // M6800 saat çevrimi sayısı
+};
+const OpcodeEntry& get_opcode_entry(uint8_t opcode);
+
+// Bellekteki bir komutun çözülmüş hali (komut önbelleği girdisi)
+struct DecodedInstruction {
+    OpcodeHandler handler;
+    uint16_t operand;
+    uint8_t length;         // Opcode dahil byte sayısı
+    uint8_t cycles;
+    uint8_t opcode;
+};
+
+// Temel blok: tek girişli, art arda çalışan komutlar. Dallanma, atlama, dönüş,
+// SWI veya WAI ile (ya da uzunluk sınırında) biter.
+struct DecodedBlock {
+    uint16_t start;
+    uint32_t end;           // Son byte'tan bir sonraki adres
+    uint64_t cycles = 0;    // Bloktaki komutların toplam çevrimi
+    std::vector<DecodedInstruction> instructions;
+};
+
+// Emulator::run'ın neden durduğu (DLL üzerinden int olarak döner, değerleri değiştirmeyin)
+enum class StopReason : int {
+    MAX_STEPS = 0,       // İstenen adım sayısı tamamlandı
+    SWI = 1,             // SWI komutu çalıştırıldı
+    UNKNOWN_OPCODE = 2,  // PC tanımsız bir opcode'u gösteriyor (çalıştırılmadı)
+    BREAKPOINT = 3,      // PC bir kesme noktasına geldi (çalıştırılmadı)
+    PC_OUT_OF_RANGE = 4, // PC [pc_min, pc_max] aralığının dışına çıktı
+    MAX_CYCLES = 5,      // İstenen çevrim sayısı tamamlandı
+    HISTORY_EMPTY = 6,   // reverse_run: geri alınacak kayıt kalmadı
+    WATCHPOINT = 7,      // Son komut izlenen bir adresi okudu/yazdı (ayrıntı: take_watch_hit)
+    WAITING = 8          // WAI ile kesme bekleniyor ve onu uyandıracak olay yok (NMI/IRQ gelince devam eder)
+};
+
+// UNTHROTTLED: olabildiğince hızlı. PACED: clock_hz hızını gerçek zamanda tutar;
+// uyku/yetişme kararı her komutta değil, birkaç milisaniyelik dilimlerde verilir.
+enum class ExecutionMode : int {
+    UNTHROTTLED = 0,
+    PACED = 1
+};
+
+// Emulator::run için durma koşulları
+struct RunConditions {
+    uint64_t max_steps = 0;
+    uint64_t max_cycles = 0;            // 0: çevrim sınırı yok
+    ExecutionMode mode = ExecutionMode::UNTHROTTLED;
+    uint32_t clock_hz = 1000000;        // PACED modunda hedef saat (varsayılan 1 MHz)
+    const uint16_t* breakpoints = nullptr;
+    int breakpoint_count = 0;
+    uint16_t pc_min = 0x0000;
+    uint16_t pc_max = 0xFFFF;
+};
+
+// Bir M6800 makinesi: kendi CPU durumu, 64KB belleği, iz ayarları ve geçmişi vardır.
+// Örnekler arasında paylaşılan tek veri değişmez (constexpr) opcode tablosudur; bu
+// yüzden farklı örnekler farklı iş parçacıklarında aynı anda çalıştırılabilir.
+// Tek bir örnek ise aynı anda yalnızca bir iş parçacığından kullanılmalıdır.
+class Emulator {
+public:
+    static constexpr size_t MEMORY_SIZE = 65536;
+
+    Emulator();
+
+    CPUState cpu;
+    std::vector<uint8_t> memory; // 64KB; hiç yeniden boyutlandırılmaz, data() sabittir
+    // CPU erişimlerinin geçtiği sayfa tablosu (varsayılan: her yer RAM). ROM, boşluk ve
+    // cihaz eşlemeleri bus.map / bus.attach ile kurulur; memory bunların arkasındaki depodur.
+    MemoryBus bus;
+    Tracer tracer;
+
+    void initialize();       // Belleği sıfırlar, CPU'yu başlangıç durumuna getirir (bus eşlemesi korunur, cihazlar resetlenir)
+    // CPU yazmaçlarını ve çevrim sayacını sıfırlar. Olay zamanları çevrim sayacına bağlı
+    // olduğundan bekleyen olaylar, kesme istekleri silinir ve cihazlar da resetlenir.
+    void reset_cpu_state();
+    void reset_from_vector();  // reset_cpu_state, ardından PC = ($FFFE)
+    void load_program_to_memory(const std::vector<uint8_t>& program_bytes, uint16_t start_address);
+    // CPU erişimleri: bus sayfa tablosuna göre RAM/ROM'a doğrudan, cihaz sayfalarında cihaza gider
+    uint8_t read_memory_byte(uint16_t address);
+    void write_memory_byte(uint16_t address, uint8_t value);
+    uint16_t read_memory_word(uint16_t address);
+    void write_memory_word(uint16_t address, uint16_t value);
+    // Toplu erişim: 64KB sınırını aşan kısım kırpılır, kopyalanan byte sayısı döner.
+    // Bus'ı atlayıp doğrudan memory'ye gider (ROM'a yükleme yapılabilir, cihazlar etkilenmez).
+    size_t read_memory_range(uint16_t start_address, uint8_t* out_bytes, size_t length);
+    size_t write_memory_range(uint16_t start_address, const uint8_t* bytes, size_t length);
+
+    // Kirli sayfa takibi: write_memory_* ve program yükleme, yazdıkları 256 byte'lık
+    // sayfaları işaretler. take_* fonksiyonları son çağrıdan beri yazılan sayfaları
+    // döndürür ve döndürdüklerinin bitlerini temizler (max dolarsa kalanlar bir sonraki
+    // çağrıya kalır). Not: memory.data() üzerinden yapılan doğrudan yazmalar izlenmez.
+    size_t take_dirty_pages(uint8_t* out_pages, size_t max_pages);  // Sayfa numaraları (adres >> 8)
+    size_t take_dirty_ranges(uint32_t* out_starts, uint32_t* out_lengths, size_t max_ranges); // Birleşik aralıklar
+
+    uint8_t fetch_byte_and_increment_pc();
+    uint16_t fetch_word_and_increment_pc();
+
+    void execute_single_step(); // Tek bir komut çalıştırır
 
-// Emülatör Fonksiyon Bildirimleri
-void initialize_emulator(); // Emülatörü ve CPU'yu başlangıç durumuna getirir
-void reset_cpu_state();     // Sadece CPU yazmaçlarını resetler
-void load_program_to_memory(const std::vector<uint8_t>& program_bytes, uint16_t start_address);
-uint8_t read_memory_byte(uint16_t address);
-void write_memory_byte(uint16_t address, uint8_t value);
-uint16_t read_memory_word(uint16_t address);
-void write_memory_word(uint16_t address, uint16_t value);
-void execute_single_step(InstructionSet& inst_set); // Tek bir komut çalıştırır
+    // Koşullardan biri sağlanana kadar komut çalıştırır. İlk adımda kesme noktası
+    // kontrol edilmez; böylece bir kesme noktasında durulduktan sonra devam edilebilir.
+    // conditions.breakpoints'e ek olarak set_breakpoint ile kurulan noktalar da geçerlidir.
+    StopReason run(const RunConditions& conditions, uint64_t& steps_executed);
+
+    // Kalıcı kesme ve izleme noktaları: her tür için 16-bit adres uzayı üzerinde bir bitmap.
+    // Çalıştırma kesme noktaları run() içinde komut getirilmeden önce, izleme noktaları
+    // read_memory_byte / write_memory_byte içinde denetlenir; bitmap'te bit yoksa koşula hiç
+    // bakılmaz. [address, address + length) aralığının tamamı aynı koşulu paylaşır.
+    // Hata ayıklayıcı erişimleri (read/write_memory_range, DLL bellek okuma) tetiklemez.
+    void set_breakpoint(WatchKind kind, uint16_t address, uint32_t length = 1, const BreakCondition& condition = {});
+    void clear_breakpoint(WatchKind kind, uint16_t address, uint32_t length = 1);
+    void clear_breakpoints();
+    bool has_breakpoint(WatchKind kind, uint16_t address) const { return break_maps[static_cast<int>(kind)].test(address); }
+    // Son run()/execute_single_step'ten beri tetiklenen izleme noktası varsa out'a yazar ve temizler
+    bool take_watch_hit(WatchHit& out);
+    // Çözülmüş komut önbelleği (varsayılan açık). Sadece iz kapalıyken run() tarafından
+    // kullanılır; belleğe yazılan her byte önbellekteki kodu geçersiz kılar.
+    void set_decode_cache(bool enabled);
+
+    // Snapshot ve geri alma. Geçmiş, yazma anında kopyalanan 256 byte'lık sayfalarla
+    // tutulur: snapshot almak sabit maliyetlidir, bellek sadece sonrasında yazılan
+    // sayfalar kadar büyür. Toplam boyut bütçeyi aşarsa en eski kayıtlar atılır.
+    void set_history_budget(size_t budget_bytes); // 0: geçmişi kapatır ve temizler
+    void set_step_recording(bool enabled);        // Her komuttan önce otomatik snapshot (bütçe > 0 olmalı)
+    uint64_t take_snapshot();                     // Snapshot kimliği; geçmiş kapalıysa 0
+    bool restore_snapshot(uint64_t snapshot_id);  // Sonraki kayıtlar atılır, snapshot kendisi kalır
+    bool reverse_step();                          // En son kayda döner ve onu atar
+    size_t history_size() const { return history.size(); }
+    // Kesme noktasına, PC aralığı dışına veya max_steps geri adıma kadar geri gider
+    StopReason reverse_run(const RunConditions& conditions, uint64_t& steps_reversed);
+
+    // Komut profilleyicisi (varsayılan kapalı). Açıkken execute_single_step ve run() her
+    // komutun adresine bir çalıştırma ve çevrimlerini ekler; kapatmak sayaçları silmez.
+    // call_graph ise JSR/BSR/RTS/RTI ve kesme girişleriyle gölge çağrı yığını da tutulur.
+    // Etiketlere göre özet için fold_profile / fold_call_graph(profile(), etiketler) kullanılır.
+    void set_profiling(bool enabled, bool call_graph = false);
+    bool profiling() const { return execution_profile.enabled(); }
+    void clear_profile();
+    const ExecutionProfile& profile() const { return execution_profile; }
+    // profile_report_dll / call_graph_report_dll'in son döndürdüğü metin (tutamaçla aynı ömür)
+    std::string profile_report_text;
+
+    // Kesmeler. Komut sınırında önce NMI, sonra (I bayrağı temizse) IRQ kabul edilir:
+    // PC, IX, A, B, CCR yığına itilir, I kurulur ve PC vektörden yüklenir. WAI çerçeveyi
+    // önceden ittiği için kesme geldiğinde yalnızca vektöre dallanılır; beklerken zaman
+    // komut çalıştırılmadan bir sonraki olaya atlar.
+    // SWI vektörü ($FFFA) 0 ise SWI eskisi gibi programın sonu sayılır ve run() SWI döndürür.
+    static constexpr uint16_t IRQ_VECTOR = 0xFFF8;
+    static constexpr uint16_t SWI_VECTOR = 0xFFFA;
+    static constexpr uint16_t NMI_VECTOR = 0xFFFC;
+    static constexpr uint16_t RESET_VECTOR = 0xFFFE;
+    static constexpr uint8_t INTERRUPT_CYCLES = 12;             // Donanım kesmesi girişinin çevrimi
+    static constexpr uint32_t DEVICE_IRQ_SOURCES = 0x7FFFFFFF;  // Bus'taki cihazlara dağıtılan kaynak bitleri
+    static constexpr uint32_t HOST_IRQ_SOURCE = 0x80000000;     // Dışarıdan (DLL/arayüz) sürülen IRQ hattı
+
+    // IRQ hattı "wired-OR"dur: herhangi bir kaynak biti kuruluysa hat etkindir
+    void set_irq(uint32_t source_mask, bool asserted);
+    uint32_t irq_lines() const { return irq_sources; }
+    void trigger_nmi();   // Kenar tetiklemeli; bir sonraki komut sınırında kabul edilir
+    bool waiting_for_interrupt() const { return waiting; }
+
+    // Çevrim zaman damgalı olay kuyruğu. Olaylar komut sınırlarında, zamanları geçmişse
+    // hemen dağıtılır; run() iç döngüsü cihazlara bakmadan bir sonraki olaya kadar çalışır.
+    // Not: snapshot/geri alma olayları ve kesme durumunu kaydetmez.
+    void schedule_event(uint64_t when, EventTarget* target, uint32_t tag);
+    void cancel_events(const EventTarget* target, uint32_t tag = EventQueue::ANY_TAG);
+    uint64_t next_event_time() const { return events.next_time(); }
+    // Bus sayfa türleri değişti (map/attach/clear): önbellekteki çözülmüş bloklar atılır
+    void memory_map_changed();
+
+    // Komut işleyicileri için (emulator.cpp)
+    void software_interrupt();       // SWI: vektör varsa kesme girişi, yoksa durma isteği
+    void wait_for_interrupt();       // WAI: çerçeve itildikten sonra çağrılır
+    void interrupt_mask_changed();   // CLI/TAP/RTI I bayrağını temizlemiş olabilir
+
+private:
+    using MemoryPage = std::array<uint8_t, 256>;
+
+    // Snapshot alındığı andaki yazmaçları tutar. Bellek sayfaları snapshot anında
+    // kopyalanmaz; snapshot'tan sonra bir sayfaya ilk kez yazılmadan hemen önce o
+    // sayfanın eski içeriği en üstteki snapshot'a kaydedilir.
+    struct Snapshot {
+        uint64_t id;
+        CPUState cpu;
+        std::bitset<256> saved;                             // Bu snapshot'a kaydedilmiş sayfalar
+        std::vector<std::pair<uint8_t, MemoryPage>> pages;  // (sayfa, snapshot anındaki içerik)
+    };
+    static constexpr size_t SNAPSHOT_BASE_COST = sizeof(Snapshot);
+    static constexpr size_t SNAPSHOT_PAGE_COST = sizeof(std::pair<uint8_t, MemoryPage>);
+
+    std::bitset<256> dirty_pages; // 256 byte'lık sayfa başına "son sorgudan beri yazıldı" biti
+    std::deque<Snapshot> history;
+    size_t history_budget = 0;    // Byte cinsinden; 0 ise geçmiş kapalı
+    size_t history_bytes = 0;
+    bool step_recording = false;
+    uint64_t next_snapshot_id = 1;
+
+    void mark_dirty(uint16_t address);
+    void mark_dirty_range(uint32_t start_address, size_t length);
+    void save_page_for_history(uint8_t page);
+    void trim_history();
+    void clear_history();
+    void rewind_to(size_t index, bool keep);
+
+    bool decode_cache_enabled = true;
+    std::vector<std::unique_ptr<DecodedBlock>> block_cache; // Başlangıç adresine göre; ilk kullanımda 65536 girdi
+    std::bitset<65536> code_bytes;                           // Önbellekteki bir bloğa ait byte'lar
+    std::array<std::vector<uint16_t>, 256> page_blocks;      // Sayfa -> o sayfaya değen blokların başlangıçları
+    bool block_invalidated = false;                          // Çalışan blok kendi koduna yazdı mı?
+
+    ExecutionProfile execution_profile;
+
+    std::bitset<65536> break_maps[3];                          // WatchKind'e göre
+    std::unordered_map<uint32_t, BreakCondition> break_conditions; // (tür << 16 | adres) -> koşul
+    std::vector<uint16_t> execute_breakpoints;                  // break_maps[EXECUTE]'taki adresler (sıralı)
+    std::vector<uint16_t> run_breakpoints;                      // run(): kalıcı + RunConditions noktaları
+    bool watch_reads = false;
+    bool watch_writes = false;
+    bool stop_requested = false;   // Döngü bu komuttan sonra requested_stop ile durur
+    StopReason requested_stop = StopReason::WATCHPOINT;
+    bool watch_hit_pending = false;
+    WatchHit last_watch_hit{};
+
+    void request_stop(StopReason reason);
+    void watch_access(WatchKind kind, uint16_t address, uint8_t value);
+    bool condition_holds(WatchKind kind, uint16_t address, uint8_t value) const;
+    void refresh_breakpoints(WatchKind kind);
+    friend bool should_stop(const Emulator& emu, const RunConditions& conditions, const std::bitset<65536>& breakpoint_map,
+                            uint64_t cycle_limit, uint64_t steps_executed, StopReason& reason);
+
+    EventQueue events;
+    uint32_t irq_sources = 0;      // Kaynak başına bir bit; 0 değilse IRQ hattı etkin
+    bool nmi_pending = false;
+    bool waiting = false;          // WAI çalıştı, kesme bekleniyor (çerçeve yığında)
+
+    bool interrupt_ready() const { return nmi_pending || (irq_sources != 0 && !cpu.get_I_flag()); }
+    void service_interrupt();      // interrupt_ready() iken komut sınırında çağrılır
+    void wake();                   // Çalışan döngüyü bir sonraki komut sınırında olay/kesme işlemeye döndürür
+
+    uint8_t fetch_code_byte(uint16_t address);
+    uint8_t peek_code_byte(uint16_t address) const;
+    DecodedInstruction decode_at(uint16_t address);
+    const DecodedBlock* get_block(uint16_t address);
+    void invalidate_code_range(uint32_t start_address, uint32_t end_address);
+    void clear_code_cache();
+    template <bool Profiled>
+    StopReason run_blocks(const RunConditions& conditions, const std::bitset<65536>& breakpoint_map,
+                          uint64_t cycle_limit, uint64_t& steps_executed);
+
+    // Traced/Profiled seçimi run() içinde bir kez yapılır; kapalı özellikler için kod üretilmez
+    template <bool Traced, bool Profiled> const OpcodeEntry& step_instruction(const DecodedInstruction& decoded);
+    template <bool Traced, bool Profiled>
+    StopReason run_mode(const RunConditions& conditions, const std::bitset<65536>& breakpoint_map,
+                        uint64_t cycle_limit, uint64_t& steps_executed);
+    template <bool Traced, bool Profiled>
+    StopReason run_loop(const RunConditions& conditions, const std::bitset<65536>& breakpoint_map,
+                        uint64_t cycle_limit, uint64_t& steps_executed);
+    template <bool Traced, bool Profiled>
+    StopReason run_events(const RunConditions& conditions, const std::bitset<65536>& breakpoint_map,
+                          uint64_t cycle_limit, uint64_t& steps_executed);
+    template <bool Traced, bool Profiled>
+    StopReason run_paced(const RunConditions& conditions, const std::bitset<65536>& breakpoint_map,
+                         uint64_t cycle_limit, uint64_t& steps_executed);
+};
 
 // Bayrakları güncellemek için yardımcı fonksiyonlar (emulator.cpp'de tanımlanacak)
-void update_N_flag(uint8_t result);
-void update_Z_flag(uint8_t result);
-void update_Z_flag_word(uint16_t result); // 16-bit işlemler için (CPX gibi)
+void update_N_flag(CPUState& cpu, uint8_t result);
+void update_Z_flag(CPUState& cpu, uint8_t result);
+void update_Z_flag_word(CPUState& cpu, uint16_t result); // 16-bit işlemler için (CPX gibi)
 // V, C, H bayrakları için daha karmaşık güncellemeler gerekecek, komutlara özel olacak.
 
 #endif // EMULATOR_HPP
\ No newline at end of file
@@ -1,67 +1,618 @@
-#include "emulator.hpp"       // CPUState, initialize_emulator, execute_single_step vb.
-#include "main.hpp"           // InstructionSet ve belki assembler fonksiyonları için
-#include "set_initializer.hpp" // set_initializer için
+#include "emulator.hpp"       // Emulator, CPUState, RunConditions vb.
+#include "trace.hpp"          // İz seviyesi ve halka tampon için
+#include "assembler.hpp"      // assemble_string_dll için AssemblyContext
+#include "assembly_session.hpp" // Editör için artımlı derleme oturumu
+#include "set_initializer.hpp" // Gömülü komut tablosu için
+#include "object_format.hpp"  // load_object_dll için raw / S19 / Intel HEX okuyucu
+#include "listing.hpp"        // assembly_listing_dll için yapılandırılmış listeleme
+#include "profiler.hpp"       // profile_report_dll için etiket düzeyinde özet
+#include "breakpoints.hpp"    // set_breakpoint_dll koşul ayrıştırıcısı
+#include "devices.hpp"        // attach_device_dll için hazır cihaz modelleri
+#include <algorithm>
+#include <cstring>
+#include <sstream>
 
-// InstructionSet için global bir örnek (veya initialize_engine içinde oluşturulup yönetilebilir)
-InstructionSet global_instruction_set;
-bool engine_initialized = false;
+// Her emülatör örneği kendi CPU'sunu, belleğini, iz ayarlarını ve geçmişini taşır;
+// paylaşılan tek durum değişmez opcode tablosudur. Bu yüzden farklı örnekler farklı
+// iş parçacıklarında aynı anda çalıştırılabilir (tek bir örnek aynı anda tek iş parçacığından).
+// Python tarafı create_emulator_dll'den aldığı işaretçiyi opak bir tutamaç olarak saklar
+// ve diğer tüm fonksiyonlara ilk parametre olarak geçirir.
+
+// assemble_string_dll çıktısı: C tarafı için düz yapılar (arayuz.py'deki ctypes tanımlarıyla aynı düzen)
+struct AsmSegmentInfo {
+    uint32_t offset;     // code dizisi içindeki başlangıç
+    uint32_t length;
+    uint16_t address;    // Bellekteki yükleme adresi
+};
+
+struct AsmSymbolInfo {
+    const char* name;
+    int32_t address;
+};
+
+struct AsmDiagnosticInfo {
+    int32_t line;
+    int32_t is_error;    // 0 ise uyarı
+    const char* message;
+    int32_t column;      // 1'den başlar; bilinmiyorsa 0
+};
+
+struct AssemblyOutput {
+    const uint8_t* code;
+    uint32_t code_length;
+    const AsmSegmentInfo* segments;
+    uint32_t segment_count;
+    const AsmSymbolInfo* symbols;        // Adrese göre sıralı
+    uint32_t symbol_count;
+    const AsmDiagnosticInfo* diagnostics;
+    uint32_t diagnostic_count;
+    int32_t error_count;
+    uint16_t org_address;                // İlk ORG (yoksa 0); program buradan başlar
+};
+
+// AssemblyOutput'taki işaretçilerin gösterdiği tamponların sahibi
+struct AssemblyResult {
+    std::vector<uint8_t> code;
+    std::vector<AsmSegmentInfo> segments;
+    std::vector<std::string> symbol_names;
+    std::vector<AsmSymbolInfo> symbols;
+    std::vector<std::string> messages;
+    std::vector<AsmDiagnosticInfo> diagnostics;
+    AssemblyListing listing;
+    std::string listing_text;            // assembly_listing_dll'in son döndürdüğü metin
+};
+
+// edit_assembly_session_dll çıktısı: son düzenlemenin yamaları (patches[i].offset bytes içindedir)
+struct SessionEditOutput {
+    const uint8_t* bytes;
+    uint32_t byte_count;
+    const AsmSegmentInfo* patches;       // Adrese göre sıralı
+    uint32_t patch_count;
+    uint32_t reencoded_lines;            // Yeniden kodlanan satır sayısı
+    int32_t error_count;                 // Oturumdaki toplam hata sayısı
+};
+
+// Yamaların C yapılarına çevrilmiş hali; oturumla birlikte yaşar
+struct EngineAssemblySession {
+    explicit EngineAssemblySession(const InstructionSet& set) : session(set) {}
+    AssemblySession session;
+    std::vector<AsmSegmentInfo> patches;
+};
+
+// Komut seti ilk kullanımda gömülü tablodan bir kez kurulur ve tüm derlemelerce paylaşılır
+static const InstructionSet& engine_instruction_set() {
+    static const InstructionSet instruction_set = [] {
+        InstructionSet set;
+        set_initializer(set);
+        return set;
+    }();
+    return instruction_set;
+}
+
+// result->code ve result->symbol_names/symbols doldurulduktan sonra bölümleri ve mesajları
+// ekler, işaretçileri bağlar ve out'u doldurur
+static void publish_assembly_result(AssemblyResult* result, const std::vector<AssemblySegment>& segments,
+                                    const std::vector<AssemblyDiagnostic>& messages, int error_count, int origin,
+                                    AssemblyOutput* out) {
+    for (const AssemblySegment& segment : segments) {
+        result->segments.push_back(AsmSegmentInfo{static_cast<uint32_t>(segment.offset),
+                                                  static_cast<uint32_t>(segment.length), segment.address});
+    }
+    for (const AssemblyDiagnostic& message : messages) {
+        result->messages.push_back(message.message);
+        result->diagnostics.push_back(AsmDiagnosticInfo{message.line, message.is_error ? 1 : 0, nullptr, message.column});
+    }
+    // İsimler vektörler tamamlandıktan sonra bağlanır (yeniden ayırma işaretçileri geçersiz kılmasın)
+    for (size_t i = 0; i < result->symbols.size(); ++i) result->symbols[i].name = result->symbol_names[i].c_str();
+    for (size_t i = 0; i < result->diagnostics.size(); ++i) result->diagnostics[i].message = result->messages[i].c_str();
+    std::sort(result->symbols.begin(), result->symbols.end(), [](const AsmSymbolInfo& a, const AsmSymbolInfo& b) {
+        return a.address != b.address ? a.address < b.address : std::strcmp(a.name, b.name) < 0;
+    });
+
+    if (out != nullptr) {
+        out->code = result->code.data();
+        out->code_length = static_cast<uint32_t>(result->code.size());
+        out->segments = result->segments.data();
+        out->segment_count = static_cast<uint32_t>(result->segments.size());
+        out->symbols = result->symbols.data();
+        out->symbol_count = static_cast<uint32_t>(result->symbols.size());
+        out->diagnostics = result->diagnostics.data();
+        out->diagnostic_count = static_cast<uint32_t>(result->diagnostics.size());
+        out->error_count = error_count;
+        out->org_address = static_cast<uint16_t>(origin);
+    }
+}
+
+// Profil raporları için derleme sonucundaki etiketler
+// result NULL ise (ör. load_object_dll ile yüklenen program) etiket yoktur
+static std::vector<std::pair<std::string, int>> result_labels(const AssemblyResult* result) {
+    std::vector<std::pair<std::string, int>> labels;
+    if (result == nullptr) return labels;
+    for (const AsmSymbolInfo& symbol : result->symbols) labels.emplace_back(symbol.name, symbol.address);
+    return labels;
+}
 
 // DLL'den dışa aktarılacak fonksiyonları extern "C" ile sarmala
 extern "C" {
 
-    // Motoru ve komut setini başlat
-    __declspec(dllexport) void initialize_engine_dll() { // Fonksiyon adını değiştirdim çakışmasın diye
-        if (!engine_initialized) {
-            set_initializer(global_instruction_set); // Komut setini yükle
-            initialize_emulator();                   // Emülatörü başlat
-            engine_initialized = true;
-            std::cout << "Engine DLL initialized." << std::endl;
-        }
+    // Yeni bir emülatör örneği oluşturur (bellek sıfırlanmış, CPU reset durumunda)
+    __declspec(dllexport) Emulator* create_emulator_dll() {
+        Emulator* emu = new Emulator();
+        emu->initialize();
+        emu->tracer.message("Emulator instance created.");
+        return emu;
+    }
+
+    // create_emulator_dll ile oluşturulan örneği yok eder; sonrasında tutamaç kullanılamaz
+    __declspec(dllexport) void destroy_emulator_dll(Emulator* emu) {
+        delete emu;
     }
 
     // CPU durumunu resetle
-    __declspec(dllexport) void reset_cpu_dll() {
-        if (!engine_initialized) initialize_engine_dll();
-        reset_cpu_state();
+    __declspec(dllexport) void reset_cpu_dll(Emulator* emu) {
+        emu->reset_cpu_state();
+    }
+
+    // Donanım reset'i gibi: CPU ve cihazlar resetlenir, PC reset vektöründen ($FFFE) yüklenir
+    __declspec(dllexport) void reset_from_vector_dll(Emulator* emu) {
+        emu->reset_from_vector();
+    }
+
+    // Dış IRQ hattını sürer (cihazların hatlarıyla wired-OR). asserted: 0 bırak, 1 etkinleştir.
+    // Hat bırakılana kadar etkin kalır; I bayrağı temizse bir sonraki komut sınırında kabul edilir.
+    __declspec(dllexport) void set_irq_dll(Emulator* emu, int asserted) {
+        emu->set_irq(Emulator::HOST_IRQ_SOURCE, asserted != 0);
+    }
+
+    // NMI kenarı üretir; bir sonraki step_cpu_dll / run_cpu_dll'de $FFFC vektörüne gidilir
+    __declspec(dllexport) void trigger_nmi_dll(Emulator* emu) {
+        emu->trigger_nmi();
+    }
+
+    // 1: CPU WAI ile kesme bekliyor
+    __declspec(dllexport) int is_waiting_dll(Emulator* emu) {
+        return emu->waiting_for_interrupt() ? 1 : 0;
     }
 
     // Verilen byte dizisini ve başlangıç adresini alarak programı belleğe yükle
-    __declspec(dllexport) void load_program_dll(const uint8_t* program_bytes, int length, uint16_t start_address) {
-        if (!engine_initialized) initialize_engine_dll();
+    __declspec(dllexport) void load_program_dll(Emulator* emu, const uint8_t* program_bytes, int length, uint16_t start_address) {
         if (program_bytes == nullptr || length <= 0) return;
         std::vector<uint8_t> code_vector(program_bytes, program_bytes + length);
-        load_program_to_memory(code_vector, start_address);
+        emu->load_program_to_memory(code_vector, start_address);
     }
 
     // Tek bir CPU adımı çalıştır
-    __declspec(dllexport) void step_cpu_dll() {
-        if (!engine_initialized) initialize_engine_dll();
-        execute_single_step(global_instruction_set);
+    __declspec(dllexport) void step_cpu_dll(Emulator* emu) {
+        emu->execute_single_step();
     }
 
     // Mevcut CPU durumunu (yazmaçlar, bayraklar) döndür
-    __declspec(dllexport) CPUState get_cpu_state_dll() {
-        // initialize_engine_dll(); // Her çağrıda gerekmeyebilir, CPUState zaten global cpu'yu kopyalar.
-        return cpu; // Global cpu nesnesini döndür
+    __declspec(dllexport) CPUState get_cpu_state_dll(Emulator* emu) {
+        return emu->cpu;
+    }
+
+    // Durma koşullarından biri sağlanana kadar (en fazla max_steps komut / max_cycles
+    // çevrim) çalıştırır. max_cycles = 0 çevrim sınırı yok demektir; max_steps = 0 ise hiç
+    // komut çalıştırılmadan MAX_STEPS döner. paced != 0 ise clock_hz hızında gerçek zamanlı çalışır.
+    // Durma nedenini (StopReason) döndürür; son CPU durumu ve çalıştırılan adım
+    // sayısı tek çağrıda out parametrelerine yazılır. breakpoints NULL olabilir.
+    __declspec(dllexport) int run_cpu_dll(Emulator* emu, uint32_t max_steps, uint64_t max_cycles, int paced, uint32_t clock_hz,
+                                          const uint16_t* breakpoints, int breakpoint_count,
+                                          uint16_t pc_min, uint16_t pc_max, CPUState* out_state, uint32_t* out_steps) {
+        RunConditions conditions;
+        conditions.max_steps = max_steps;
+        conditions.max_cycles = max_cycles;
+        conditions.mode = paced ? ExecutionMode::PACED : ExecutionMode::UNTHROTTLED;
+        conditions.clock_hz = clock_hz;
+        conditions.breakpoints = breakpoints;
+        conditions.breakpoint_count = (breakpoints != nullptr) ? breakpoint_count : 0;
+        conditions.pc_min = pc_min;
+        conditions.pc_max = pc_max;
+
+        uint64_t steps_executed = 0;
+        StopReason reason = emu->run(conditions, steps_executed);
+
+        if (out_state != nullptr) *out_state = emu->cpu;
+        if (out_steps != nullptr) *out_steps = static_cast<uint32_t>(steps_executed);
+        return static_cast<int>(reason);
+    }
+
+    // Çözülmüş komut önbelleğini açar/kapatır (varsayılan açık; 0 kapatır ve belleğini bırakır)
+    __declspec(dllexport) void set_decode_cache_dll(Emulator* emu, int enabled) {
+        emu->set_decode_cache(enabled != 0);
+    }
+
+    // Kalıcı kesme (kind 0) veya okuma/yazma izleme noktası (kind 1/2) kurar. [address,
+    // address + length) aralığındaki her adres aynı koşulu alır; condition NULL veya boşsa
+    // koşulsuzdur, aksi halde "A==$05", "X>=$0200", "[$0051]!=0", "VAL&$80" biçimindedir.
+    // Koşul geçersizse hiçbir şey kurulmaz ve 0 döner.
+    __declspec(dllexport) int set_breakpoint_dll(Emulator* emu, int kind, uint16_t address, int length, const char* condition) {
+        if (kind < 0 || kind > 2 || length <= 0) {
+            std::cerr << "Hata: set_breakpoint_dll gecersiz tur/uzunluk " << kind << "/" << length << std::endl;
+            return 0;
+        }
+        BreakCondition parsed;
+        std::string error;
+        if (!parse_break_condition(condition != nullptr ? std::string_view(condition) : std::string_view(), parsed, error)) {
+            std::cerr << "Hata: " << error << std::endl;
+            return 0;
+        }
+        emu->set_breakpoint(static_cast<WatchKind>(kind), address, static_cast<uint32_t>(length), parsed);
+        return 1;
+    }
+
+    __declspec(dllexport) void clear_breakpoint_dll(Emulator* emu, int kind, uint16_t address, int length) {
+        if (kind < 0 || kind > 2 || length <= 0) return;
+        emu->clear_breakpoint(static_cast<WatchKind>(kind), address, static_cast<uint32_t>(length));
+    }
+
+    __declspec(dllexport) void clear_breakpoints_dll(Emulator* emu) {
+        emu->clear_breakpoints();
+    }
+
+    // run_cpu_dll WATCHPOINT (7) döndürdüğünde veya step_cpu_dll sonrasında tetiklenen izleme
+    // noktasını out'a yazar ve 1 döndürür; tetiklenen yoksa 0
+    __declspec(dllexport) int take_watch_hit_dll(Emulator* emu, WatchHit* out) {
+        WatchHit hit;
+        if (!emu->take_watch_hit(hit)) return 0;
+        if (out != nullptr) *out = hit;
+        return 1;
+    }
+
+    // [start, start + length) aralığına değen 256 byte'lık sayfaları kind yapar (0 RAM, 1 ROM,
+    // 3 boşluk). Bu sayfalardaki cihazlar çıkarılır. Geçersiz türde 0 döner.
+    __declspec(dllexport) int map_memory_dll(Emulator* emu, uint16_t start, int length, int kind) {
+        if (length <= 0 || kind < static_cast<int>(PageKind::RAM) || kind > static_cast<int>(PageKind::UNMAPPED)
+            || !emu->bus.map(start, static_cast<uint32_t>(length), static_cast<PageKind>(kind))) {
+            std::cerr << "Hata: map_memory_dll gecersiz tur/uzunluk " << kind << "/" << length << std::endl;
+            return 0;
+        }
+        return 1;
+    }
+
+    // Hazır bir cihazı (type: 0 UART, 1 zamanlayıcı, 2 PIA) base adresine takar; yazmaç düzenleri
+    // devices.hpp'de. Başka bir cihazla örtüşürse takılmaz ve 0 döner.
+    __declspec(dllexport) int attach_device_dll(Emulator* emu, int type, uint16_t base) {
+        std::unique_ptr<MemoryDevice> device;
+        switch (static_cast<DeviceType>(type)) {
+            case DeviceType::UART: device = std::make_unique<UartDevice>(); break;
+            case DeviceType::TIMER: device = std::make_unique<TimerDevice>(); break;
+            case DeviceType::PIA: device = std::make_unique<PiaDevice>(); break;
+            default:
+                std::cerr << "Hata: attach_device_dll gecersiz cihaz turu " << type << std::endl;
+                return 0;
+        }
+        if (emu->bus.attach(base, std::move(device)) == nullptr) {
+            std::cerr << "Hata: cihaz $" << std::hex << base << std::dec << " adresine takilamadi (ortusme)" << std::endl;
+            return 0;
+        }
+        return 1;
+    }
+
+    // Bütün cihazları çıkarır ve bütün belleği RAM yapar
+    __declspec(dllexport) void clear_devices_dll(Emulator* emu) {
+        emu->bus.clear();
+    }
+
+    // base'deki UART'ın gönderdiği byte'lardan en fazla max_bytes tanesini out'a kopyalar ve
+    // tampondan çıkarır. Kopyalanan byte sayısını, orada UART yoksa -1 döndürür.
+    __declspec(dllexport) int uart_take_output_dll(Emulator* emu, uint16_t base, uint8_t* out, int max_bytes) {
+        auto* uart = dynamic_cast<UartDevice*>(emu->bus.device_at(base));
+        if (uart == nullptr) return -1;
+        if (out == nullptr || max_bytes <= 0) return 0;
+        std::string bytes = uart->take_output(static_cast<size_t>(max_bytes));
+        std::memcpy(out, bytes.data(), bytes.size());
+        return static_cast<int>(bytes.size());
+    }
+
+    // base'deki UART'ın alma kuyruğuna byte ekler (program RDRF ile görür); UART yoksa 0
+    __declspec(dllexport) int uart_feed_input_dll(Emulator* emu, uint16_t base, const uint8_t* bytes, int length) {
+        auto* uart = dynamic_cast<UartDevice*>(emu->bus.device_at(base));
+        if (uart == nullptr) return 0;
+        if (bytes != nullptr && length > 0) uart->feed_input(bytes, static_cast<size_t>(length));
+        return 1;
+    }
+
+    // base'deki PIA'nın port'una (0 A, 1 B) host tarafından giriş değeri verir; PIA yoksa 0
+    __declspec(dllexport) int pia_set_input_dll(Emulator* emu, uint16_t base, int port, uint8_t value) {
+        auto* pia = dynamic_cast<PiaDevice*>(emu->bus.device_at(base));
+        if (pia == nullptr) return 0;
+        pia->set_input(port, value);
+        return 1;
+    }
+
+    // PIA port'unun çıkış olarak ayarlanmış bitlerinin değeri; PIA yoksa -1
+    __declspec(dllexport) int pia_get_output_dll(Emulator* emu, uint16_t base, int port) {
+        auto* pia = dynamic_cast<PiaDevice*>(emu->bus.device_at(base));
+        return (pia != nullptr) ? pia->output(port) : -1;
+    }
+
+    // PIA port'unun CA1/CB1 hattını level'a çeker; kontrol yazmacındaki kenar gelirse bayrak kurulur
+    __declspec(dllexport) int pia_set_control_line_dll(Emulator* emu, uint16_t base, int port, int level) {
+        auto* pia = dynamic_cast<PiaDevice*>(emu->bus.device_at(base));
+        if (pia == nullptr) return 0;
+        pia->set_control_line(port, level != 0);
+        return 1;
+    }
+
+    // Komut profilleyicisini açar/kapatır (varsayılan kapalı). enabled: 0 kapalı, 1 adres
+    // sayaçları, 2 adres sayaçları ve çağrı grafiği. Kapatmak sayaçları silmez.
+    __declspec(dllexport) void set_profiling_dll(Emulator* emu, int enabled) {
+        emu->set_profiling(enabled != 0, enabled >= 2);
+    }
+
+    __declspec(dllexport) void clear_profile_dll(Emulator* emu) {
+        emu->clear_profile();
+    }
+
+    // [start_address, start_address + count) adreslerinin ham sayaçlarını kopyalar (çıktılardan
+    // biri NULL olabilir). Profilleyici hiç açılmadıysa 0, değilse kopyalanan adres sayısı döner.
+    __declspec(dllexport) int read_profile_dll(Emulator* emu, uint16_t start_address, int count,
+                                               uint64_t* out_hits, uint64_t* out_cycles) {
+        const std::vector<ProfileCounter>& counters = emu->profile().data();
+        if (counters.empty() || count <= 0) return 0;
+        size_t length = std::min<size_t>(static_cast<size_t>(count), counters.size() - start_address);
+        for (size_t i = 0; i < length; ++i) {
+            if (out_hits != nullptr) out_hits[i] = counters[start_address + i].hits;
+            if (out_cycles != nullptr) out_cycles[i] = counters[start_address + i].cycles;
+        }
+        return static_cast<int>(length);
+    }
+
+    // Sayaçları assemble_string_dll sonucundaki etiketlere göre toplar ve çevrime göre sıralar.
+    // result NULL olabilir (S19/HEX ile yüklenen program): adlar "$xxxx" olur. json != 0 ise
+    // [{"label":..,"address":..,"end":..,"hits":..,"cycles":..}], değilse sütunlu metin;
+    // limit > 0 ise ilk limit etiket. Dönen metin emülatörde tutulur ve bu fonksiyonun veya
+    // call_graph_report_dll'in bir sonraki çağrısına (ya da destroy_emulator_dll'e) kadar geçerlidir.
+    __declspec(dllexport) const char* profile_report_dll(Emulator* emu, const AssemblyResult* result, int json, int limit) {
+        std::vector<ProfileHotSpot> hot_spots = fold_profile(emu->profile(), result_labels(result));
+        size_t shown = static_cast<size_t>(std::max(limit, 0));
+        emu->profile_report_text = json ? format_profile_json(hot_spots, shown) : format_profile_report(hot_spots, shown);
+        return emu->profile_report_text.c_str();
+    }
+
+    // Çağrı grafiği (set_profiling_dll(emu, 2) ile toplanır). format: 0 alt program tablosu
+    // (kapsayıcı çevrime göre), 1 aynısı JSON, 2 flame graph araçları için collapsed stack
+    // satırları ("kök;çağıran;çağrılan ÇEVRİM"). result NULL olabilir; metnin ömrü
+    // profile_report_dll ile aynıdır.
+    __declspec(dllexport) const char* call_graph_report_dll(Emulator* emu, const AssemblyResult* result, int format, int limit) {
+        if (format == 2) {
+            emu->profile_report_text = format_collapsed_stacks(emu->profile(), result_labels(result));
+        } else {
+            std::vector<CallGraphEntry> entries = fold_call_graph(emu->profile(), result_labels(result));
+            size_t shown = static_cast<size_t>(std::max(limit, 0));
+            emu->profile_report_text = format == 1 ? format_call_graph_json(entries, shown) : format_call_graph_report(entries, shown);
+        }
+        return emu->profile_report_text.c_str();
+    }
+
+    // Geçmiş için bellek bütçesi (byte). 0 geçmişi kapatır; record_steps != 0 ise
+    // her komuttan önce snapshot alınır ve reverse_step_dll/reverse_run_dll kullanılabilir.
+    __declspec(dllexport) void set_history_dll(Emulator* emu, uint64_t budget_bytes, int record_steps) {
+        emu->set_history_budget(static_cast<size_t>(budget_bytes));
+        emu->set_step_recording(record_steps != 0);
+    }
+
+    // Anlık durumu kaydeder; snapshot kimliğini (geçmiş kapalıysa 0) döndürür
+    __declspec(dllexport) uint64_t take_snapshot_dll(Emulator* emu) {
+        return emu->take_snapshot();
+    }
+
+    // Kimliği verilen snapshot'a döner; bulunamazsa (bütçe yüzünden atılmışsa) 0 döndürür
+    __declspec(dllexport) int restore_snapshot_dll(Emulator* emu, uint64_t snapshot_id, CPUState* out_state) {
+        bool restored = emu->restore_snapshot(snapshot_id);
+        if (out_state != nullptr) *out_state = emu->cpu;
+        return restored ? 1 : 0;
+    }
+
+    // Son komutu geri alır; geçmiş boşsa 0 döndürür
+    __declspec(dllexport) int reverse_step_dll(Emulator* emu, CPUState* out_state) {
+        bool reversed = emu->reverse_step();
+        if (out_state != nullptr) *out_state = emu->cpu;
+        return reversed ? 1 : 0;
+    }
+
+    // run_cpu_dll'in geri yönlü karşılığı: kesme noktası, PC aralığı dışı, geçmişin
+    // sonu veya max_steps geri adıma kadar geri gider. Durma nedenini döndürür.
+    __declspec(dllexport) int reverse_run_dll(Emulator* emu, uint32_t max_steps, const uint16_t* breakpoints, int breakpoint_count,
+                                              uint16_t pc_min, uint16_t pc_max, CPUState* out_state, uint32_t* out_steps) {
+        RunConditions conditions;
+        conditions.max_steps = max_steps;
+        conditions.breakpoints = breakpoints;
+        conditions.breakpoint_count = (breakpoints != nullptr) ? breakpoint_count : 0;
+        conditions.pc_min = pc_min;
+        conditions.pc_max = pc_max;
+
+        uint64_t steps_reversed = 0;
+        StopReason reason = emu->reverse_run(conditions, steps_reversed);
+
+        if (out_state != nullptr) *out_state = emu->cpu;
+        if (out_steps != nullptr) *out_steps = static_cast<uint32_t>(steps_reversed);
+        return static_cast<int>(reason);
+    }
+
+    // İz seviyesini ayarla (0: kapalı, 1: özet, 2: komut başına metin, 3: halka tampon)
+    __declspec(dllexport) void set_trace_level_dll(Emulator* emu, int level) {
+        if (level < static_cast<int>(TraceLevel::OFF) || level > static_cast<int>(TraceLevel::BINARY)) return;
+        emu->tracer.set_level(static_cast<TraceLevel>(level));
+    }
+
+    // Halka tampondaki en fazla max_records TraceRecord'u (en eskiden yeniye) out_records'a
+    // kopyalar ve tampondan çıkarır. Kopyalanan kayıt sayısını döndürür.
+    __declspec(dllexport) int read_trace_records_dll(Emulator* emu, TraceRecord* out_records, int max_records) {
+        if (out_records == nullptr || max_records <= 0) return 0;
+        return static_cast<int>(emu->tracer.ring_buffer().drain(out_records, static_cast<size_t>(max_records)));
     }
 
     // Bellekten belirli bir adresteki byte'ı oku
-    __declspec(dllexport) uint8_t read_memory_dll(uint16_t address) {
-        // initialize_engine_dll();
-        return read_memory_byte(address);
+    // (Hata ayıklayıcı erişimi: izleme noktalarını tetiklemez)
+    __declspec(dllexport) uint8_t read_memory_dll(Emulator* emu, uint16_t address) {
+        uint8_t value = 0;
+        emu->read_memory_range(address, &value, 1);
+        return value;
     }
 
     // Belleğe belirli bir adrese byte yaz
-    __declspec(dllexport) void write_memory_dll(uint16_t address, uint8_t value) {
-        // initialize_engine_dll();
-        write_memory_byte(address, value);
-    }
-
-    // TODO: Assembler fonksiyonu için bir sarmalayıcı
-    // Bu fonksiyon assembly string'ini alıp, makine kodu byte dizisini ve ORG adresini döndürmeli.
-    // __declspec(dllexport) bool assemble_string_dll(const char* assembly_string, uint8_t** out_bytes, int* out_length, uint16_t* out_org_address) {
-    //     // Mevcut main.cpp'deki parse mantığınızı buraya taşıyıp, sonucu out parametreleriyle döndürün.
-    //     // Bu kısım mevcut assembler yapınızın büyük ölçüde yeniden düzenlenmesini gerektirir.
-    //     return false; // Şimdilik implemente edilmedi
-    // }
-}
\ No newline at end of file
+    __declspec(dllexport) void write_memory_dll(Emulator* emu, uint16_t address, uint8_t value) {
+        emu->write_memory_range(address, &value, 1);
+    }
+
+    // start_address'ten itibaren length byte'ı out_bytes'a kopyalar (tek çağrıda bellek dökümü).
+    // 64KB sınırında kırpılır; kopyalanan byte sayısını döndürür.
+    __declspec(dllexport) int read_memory_range_dll(Emulator* emu, uint16_t start_address, uint8_t* out_bytes, int length) {
+        if (out_bytes == nullptr || length <= 0) return 0;
+        return static_cast<int>(emu->read_memory_range(start_address, out_bytes, static_cast<size_t>(length)));
+    }
+
+    // bytes dizisini start_address'ten itibaren belleğe yazar; yazılan byte sayısını döndürür.
+    __declspec(dllexport) int write_memory_range_dll(Emulator* emu, uint16_t start_address, const uint8_t* bytes, int length) {
+        if (bytes == nullptr || length <= 0) return 0;
+        return static_cast<int>(emu->write_memory_range(start_address, bytes, static_cast<size_t>(length)));
+    }
+
+    // 64KB emülatör belleğinin başlangıç adresini döndürür. Bellek hiçbir zaman yeniden
+    // boyutlandırılmadığı için işaretçi örnek yok edilene kadar geçerlidir; Python tarafı bunu
+    // kopyalamadan (c_uint8 * 65536).from_address(...) ile sarabilir. Sadece okuma içindir:
+    // bu işaretçi üzerinden yapılan yazmalar kirli sayfa ve komut önbelleği takibini atlar.
+    __declspec(dllexport) uint8_t* get_memory_pointer_dll(Emulator* emu) {
+        return emu->memory.data();
+    }
+
+    // Son çağrıdan beri yazılan 256 byte'lık sayfaların numaralarını out_pages'e yazar
+    // (en fazla max_pages; 256 yeterlidir) ve bitlerini temizler. Sayfa sayısını döndürür.
+    __declspec(dllexport) int take_dirty_pages_dll(Emulator* emu, uint8_t* out_pages, int max_pages) {
+        if (out_pages == nullptr || max_pages <= 0) return 0;
+        return static_cast<int>(emu->take_dirty_pages(out_pages, static_cast<size_t>(max_pages)));
+    }
+
+    // take_dirty_pages_dll ile aynı, ancak ardışık sayfaları (başlangıç, uzunluk) byte
+    // aralıkları olarak birleştirir. En fazla 128 aralık oluşabilir.
+    __declspec(dllexport) int take_dirty_ranges_dll(Emulator* emu, uint32_t* out_starts, uint32_t* out_lengths, int max_ranges) {
+        if (out_starts == nullptr || out_lengths == nullptr || max_ranges <= 0) return 0;
+        return static_cast<int>(emu->take_dirty_ranges(out_starts, out_lengths, static_cast<size_t>(max_ranges)));
+    }
+
+    // Nesne dosyası içeriğini (format: 0 otomatik, 1 ham, 2 S19, 3 Intel HEX) ayrıştırıp her bölümü
+    // tek bir kopyayla kendi adresine yazar. Ham içerik raw_base'e yüklenir. PC dosyadaki başlangıç
+    // adresine, yoksa ilk bölüme kurulur. out_starts/out_lengths verilirse bölümler yazılır (en fazla
+    // max_segments). Bölüm sayısını, hata durumunda -1 döndürür (bellek değiştirilmez).
+    __declspec(dllexport) int load_object_dll(Emulator* emu, const uint8_t* bytes, int length, int format, uint16_t raw_base,
+                                              uint32_t* out_starts, uint32_t* out_lengths, int max_segments) {
+        if (format < static_cast<int>(ObjectFormat::AUTO) || format > static_cast<int>(ObjectFormat::INTEL_HEX)) {
+            std::cerr << "Hata: load_object_dll gecersiz bicim " << format << std::endl;
+            return -1;
+        }
+        ObjectImage image;
+        std::string error;
+        if (!read_object(bytes, length > 0 ? static_cast<size_t>(length) : 0, static_cast<ObjectFormat>(format),
+                         raw_base, image, error)) {
+            std::cerr << "Hata: " << error << std::endl;
+            return -1;
+        }
+        for (size_t i = 0; i < image.segments.size(); ++i) {
+            const AssemblySegment& segment = image.segments[i];
+            emu->write_memory_range(segment.address, image.data.data() + segment.offset, segment.length);
+            if (out_starts != nullptr && out_lengths != nullptr && i < static_cast<size_t>(std::max(max_segments, 0))) {
+                out_starts[i] = segment.address;
+                out_lengths[i] = static_cast<uint32_t>(segment.length);
+            }
+        }
+        if (image.has_entry) emu->cpu.pc = image.entry;
+        else if (!image.segments.empty()) emu->cpu.pc = image.segments.front().address;
+        return static_cast<int>(image.segments.size());
+    }
+
+    // Kaynağı süreç içinde derler (geçici dosya, alt süreç ve çıktı ayrıştırma gerekmez).
+    // Dönen sonuç free_assembly_dll ile bırakılana kadar out'taki tüm işaretçiler geçerlidir.
+    __declspec(dllexport) AssemblyResult* assemble_string_dll(const char* source, AssemblyOutput* out) {
+        auto* result = new AssemblyResult();
+        std::ostringstream diagnostics_text;
+        AssemblyContext ctx(engine_instruction_set(), diagnostics_text);
+        ctx.listing = &result->listing;
+        assemble_buffer(ctx, source != nullptr ? std::string_view(source) : std::string_view());
+
+        result->code = std::move(ctx.programData);
+        ctx.symbolTable.for_each_symbol([&](std::string_view name, int address) {
+            result->symbol_names.emplace_back(name);
+            result->symbols.push_back(AsmSymbolInfo{nullptr, address});
+        });
+        publish_assembly_result(result, ctx.segments, ctx.messages, ctx.error_count, ctx.origin, out);
+        return result;
+    }
+
+    // Sonucun satır satır listelemesi (adres, byte'lar, çevrim, etiket, kaynak). json != 0 ise
+    // {"lines":[...],"symbols":[...],"diagnostics":[...]} biçiminde, değilse sütunlu metin.
+    // Dönen metin free_assembly_dll'e (veya bu fonksiyonun bir sonraki çağrısına) kadar geçerlidir.
+    __declspec(dllexport) const char* assembly_listing_dll(AssemblyResult* result, int json) {
+        result->listing_text = json ? format_listing_json(result->listing) : format_listing_text(result->listing);
+        return result->listing_text.c_str();
+    }
+
+    // assemble_string_dll'in döndürdüğü sonucu ve gösterdiği tüm tamponları bırakır
+    __declspec(dllexport) void free_assembly_dll(AssemblyResult* result) {
+        delete result;
+    }
+
+    // Editör için artımlı derleme oturumu açar. İlk edit_assembly_session_dll(oturum, 0, 0, kaynak)
+    // programın tamamını derler; sonraki düzenlemelerde sadece değişen satırlar ve etkiledikleri
+    // satırlar yeniden kodlanır.
+    __declspec(dllexport) EngineAssemblySession* create_assembly_session_dll() {
+        return new EngineAssemblySession(engine_instruction_set());
+    }
+
+    __declspec(dllexport) void destroy_assembly_session_dll(EngineAssemblySession* session) {
+        delete session;
+    }
+
+    // [first_line, first_line + line_count) satırlarını (0'dan başlar) text'teki satırlarla değiştirir.
+    // out'taki yamalar önceki düzenlemeye göre değişen byte'lardır ve bir sonraki düzenlemeye kadar
+    // geçerlidir. Yeniden kodlanan satır sayısını döndürür.
+    __declspec(dllexport) int edit_assembly_session_dll(EngineAssemblySession* session, int first_line, int line_count,
+                                                        const char* text, SessionEditOutput* out) {
+        size_t reencoded = session->session.edit(static_cast<size_t>(std::max(first_line, 0)),
+                                                 static_cast<size_t>(std::max(line_count, 0)),
+                                                 text != nullptr ? std::string_view(text) : std::string_view());
+        session->patches.clear();
+        for (const MemoryPatch& patch : session->session.patches()) {
+            session->patches.push_back(AsmSegmentInfo{static_cast<uint32_t>(patch.offset),
+                                                      static_cast<uint32_t>(patch.length), patch.address});
+        }
+        if (out != nullptr) {
+            out->bytes = session->session.patch_bytes().data();
+            out->byte_count = static_cast<uint32_t>(session->session.patch_bytes().size());
+            out->patches = session->patches.data();
+            out->patch_count = static_cast<uint32_t>(session->patches.size());
+            out->reencoded_lines = static_cast<uint32_t>(reencoded);
+            out->error_count = session->session.error_count();
+        }
+        return static_cast<int>(reencoded);
+    }
+
+    // Son düzenlemenin yamalarını emülatör belleğine yazar (kirli sayfa ve komut önbelleği
+    // takibiyle); PC ve registerlar değişmez. Yazılan byte sayısını döndürür.
+    __declspec(dllexport) int apply_session_patches_dll(Emulator* emu, EngineAssemblySession* session) {
+        const std::vector<uint8_t>& bytes = session->session.patch_bytes();
+        size_t written = 0;
+        for (const MemoryPatch& patch : session->session.patches()) {
+            written += emu->write_memory_range(patch.address, bytes.data() + patch.offset, patch.length);
+        }
+        return static_cast<int>(written);
+    }
+
+    // Oturumdaki programın tamamı assemble_string_dll ile aynı biçimde (free_assembly_dll ile bırakılır)
+    __declspec(dllexport) AssemblyResult* assembly_session_output_dll(EngineAssemblySession* session, AssemblyOutput* out) {
+        auto* result = new AssemblyResult();
+        std::vector<AssemblySegment> segments;
+        session->session.program(result->code, segments);
+        session->session.listing(result->listing);
+        session->session.for_each_symbol([&](std::string_view name, int address) {
+            result->symbol_names.emplace_back(name);
+            result->symbols.push_back(AsmSymbolInfo{nullptr, address});
+        });
+        bool has_origin = false;
+        int origin = session->session.origin(has_origin);
+        publish_assembly_result(result, segments, session->session.diagnostics(), session->session.error_count(),
+                                has_origin ? origin : 0, out);
+        return result;
+    }
+}
@@ -0,0 +1,26 @@
+#include "event_queue.hpp"
+#include <algorithm>
+
+void EventQueue::schedule(uint64_t when, EventTarget* target, uint32_t tag) {
+    heap.push_back(Event{when, next_sequence++, target, tag});
+    std::push_heap(heap.begin(), heap.end(), later);
+}
+
+void EventQueue::cancel(const EventTarget* target, uint32_t tag) {
+    // Kuyrukta genelde birkaç olay olur; silip yığını yeniden kurmak yeterince ucuz
+    auto removed = std::remove_if(heap.begin(), heap.end(), [&](const Event& event) {
+        return event.target == target && (tag == ANY_TAG || event.tag == tag);
+    });
+    if (removed == heap.end()) return;
+    heap.erase(removed, heap.end());
+    std::make_heap(heap.begin(), heap.end(), later);
+}
+
+void EventQueue::dispatch(uint64_t now) {
+    while (!heap.empty() && heap.front().when <= now) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        Event event = heap.back();
+        heap.pop_back();
+        event.target->on_event(event.when, event.tag);
+    }
+}
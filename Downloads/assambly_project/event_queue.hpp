@@ -0,0 +1,52 @@
+#ifndef EVENT_QUEUE_HPP
+#define EVENT_QUEUE_HPP
+
+#include <cstdint>
+#include <vector>
+
+// Zamanlanmış olay alabilen nesne (cihazlar MemoryDevice üzerinden türer)
+class EventTarget {
+public:
+    virtual ~EventTarget() = default;
+    // when: olayın zamanlandığı çevrim. Olay komut sınırında çağrıldığı için CPU'nun o anki
+    // çevrimi birkaç çevrim ileride olabilir; zamanlama hesapları when'e göre yapılmalıdır.
+    virtual void on_event(uint64_t when, uint32_t tag) = 0;
+};
+
+// CPU çevrim zaman damgasına göre sıralı olay kuyruğu (min-heap). Cihazlar her komutta
+// yoklanmaz; bir sonraki önemli anlarını (ör. zamanlayıcının dolması) buraya koyar ve
+// emülatör komutları bir sonraki olay sınırına kadar cihazlara bakmadan çalıştırır.
+// Aynı zamana düşen olaylar kuyruğa giriş sırasıyla çağrılır.
+class EventQueue {
+public:
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    void schedule(uint64_t when, EventTarget* target, uint32_t tag);
+    // target'ın tag'li olaylarını siler; ANY_TAG verilirse target'ın bütün olaylarını
+    static constexpr uint32_t ANY_TAG = UINT32_MAX;
+    void cancel(const EventTarget* target, uint32_t tag = ANY_TAG);
+    void clear() { heap.clear(); }
+
+    bool empty() const { return heap.empty(); }
+    uint64_t next_time() const { return heap.empty() ? NEVER : heap.front().when; }
+    // Zamanı now'a eşit veya daha önce olan olayları sırayla çağırır. Çağrılan hedef yeni
+    // olay zamanlayabilir; now'a düşen yeni olaylar da aynı çağrıda işlenir.
+    void dispatch(uint64_t now);
+
+private:
+    struct Event {
+        uint64_t when;
+        uint64_t sequence;    // Aynı zamandaki olayların sırası için
+        EventTarget* target;
+        uint32_t tag;
+    };
+    // std::push_heap en büyüğü başa koyar; en erken olay başta olsun diye ters karşılaştırma
+    static bool later(const Event& a, const Event& b) {
+        return a.when != b.when ? a.when > b.when : a.sequence > b.sequence;
+    }
+
+    std::vector<Event> heap;
+    uint64_t next_sequence = 0;
+};
+
+#endif // EVENT_QUEUE_HPP
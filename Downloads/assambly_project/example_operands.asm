@@ -0,0 +1,21 @@
+ORG $0100
+
+    LDX #$0210
+    LDAB #$05
+    STAB $20
+    ADDB $20
+    STAB 2,X
+    LDAB 2,X
+    STX $22
+
+    LDX #$0003
+LOOP:
+    ADDB #$01
+    DEX
+    BNE LOOP
+
+    LDX $22
+    STAB 0,X
+
+    SWI
+    END
\ No newline at end of file
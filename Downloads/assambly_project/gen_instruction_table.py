@@ -0,0 +1,114 @@
+# instructions.txt'den instruction_table.hpp üretir.
+#
+# Kullanım: python gen_instruction_table.py [instructions.txt] [instruction_table.hpp]
+#
+# Assembler ve motor komut setini bu başlıktaki constexpr tablodan kurar; böylece
+# başlangıçta dosya okuma ve ayrıştırma yapılmaz. instructions.txt her değiştiğinde
+# bu script yeniden çalıştırılmalı ve üretilen başlık da commit edilmelidir.
+# Satır biçimi set_initializer.cpp'deki çalışma zamanı okuyucusuyla aynıdır:
+#   MNEMONIC OPCODE(hex) BYTE_SAYISI ADRESLEME_MODU [ÇEVRİM]
+# Hatalı satırlar (çalışma zamanı okuyucusunun aksine) üretimi durdurur.
+
+import os
+import sys
+
+MODES = {
+    "-": "NONE", "NONE": "NONE",
+    "IMMEDIATE": "IMMEDIATE",
+    "DIRECT": "DIRECT",
+    "IMPLIED": "IMPLIED", "ACCUMULATOR": "IMPLIED",
+    "EXTENDED": "EXTENDED",
+    "INDEXED": "INDEXED",
+    "RELATIVE": "RELATIVE",
+}
+
+
+def parse_table(path):
+    entries = []
+    errors = []
+    with open(path, encoding="utf-8") as f:
+        for line_number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith(";"):
+                continue
+            fields = line.split()
+            if len(fields) < 4:
+                errors.append(f"{path}:{line_number}: hatali format: '{line}'")
+                continue
+            mnemonic, opcode_str, bytes_str, mode_str = fields[:4]
+            try:
+                opcode = int(opcode_str, 16)
+                no_of_bytes = int(bytes_str)
+                cycles = int(fields[4]) if len(fields) > 4 else 0
+            except ValueError:
+                errors.append(f"{path}:{line_number}: gecersiz sayi: '{line}'")
+                continue
+            if not 0 <= opcode <= 0xFF or not 1 <= no_of_bytes <= 3 or not 0 <= cycles <= 0xFF:
+                errors.append(f"{path}:{line_number}: deger aralik disi: '{line}'")
+                continue
+            if mode_str not in MODES:
+                errors.append(f"{path}:{line_number}: taninmayan adresleme modu '{mode_str}'")
+                continue
+            if len(mnemonic) > 8:
+                errors.append(f"{path}:{line_number}: mnemonic 8 karakterden uzun: '{mnemonic}'")
+                continue
+            entries.append((mnemonic, opcode, no_of_bytes, MODES[mode_str], cycles))
+    return entries, errors
+
+
+def render(entries, source_name):
+    out = [
+        f"// Bu dosya gen_instruction_table.py tarafından {source_name} dosyasından üretilmiştir.",
+        "// Elle düzenlemeyin; instructions.txt değiştirildikten sonra script'i yeniden çalıştırın.",
+        "#ifndef INSTRUCTION_TABLE_HPP",
+        "#define INSTRUCTION_TABLE_HPP",
+        "",
+        "#include \"main.hpp\" // AddressingMode",
+        "#include <cstdint>",
+        "",
+        "struct InstructionDefinition {",
+        "    const char* mnemonic;",
+        "    uint8_t opcode;",
+        "    uint8_t no_of_bytes;",
+        "    AddressingMode addressing_mode;",
+        "    uint8_t cycles;",
+        "};",
+        "",
+        "inline constexpr InstructionDefinition INSTRUCTION_TABLE[] = {",
+    ]
+    for mnemonic, opcode, no_of_bytes, mode, cycles in entries:
+        out.append(f"    {{\"{mnemonic}\", 0x{opcode:02X}, {no_of_bytes}, AddressingMode::{mode}, {cycles}}},")
+    out += [
+        "};",
+        "",
+        "#endif // INSTRUCTION_TABLE_HPP",
+        "",
+    ]
+    return "\n".join(out)
+
+
+def main():
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    source = sys.argv[1] if len(sys.argv) > 1 else os.path.join(script_dir, "instructions.txt")
+    target = sys.argv[2] if len(sys.argv) > 2 else os.path.join(script_dir, "instruction_table.hpp")
+
+    entries, errors = parse_table(source)
+    if errors:
+        for error in errors:
+            print(f"HATA: {error}", file=sys.stderr)
+        return 1
+
+    text = render(entries, os.path.basename(source))
+    # İçerik aynıysa dosyaya dokunma (gereksiz yeniden derlemeyi önler)
+    if os.path.exists(target):
+        with open(target, encoding="utf-8") as f:
+            if f.read() == text:
+                return 0
+    with open(target, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    print(f"{target}: {len(entries)} komut yazildi.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,217 @@
+// Bu dosya gen_instruction_table.py tarafından instructions.txt dosyasından üretilmiştir.
+// Elle düzenlemeyin; instructions.txt değiştirildikten sonra script'i yeniden çalıştırın.
+#ifndef INSTRUCTION_TABLE_HPP
+#define INSTRUCTION_TABLE_HPP
+
+#include "main.hpp" // AddressingMode
+#include <cstdint>
+
+struct InstructionDefinition {
+    const char* mnemonic;
+    uint8_t opcode;
+    uint8_t no_of_bytes;
+    AddressingMode addressing_mode;
+    uint8_t cycles;
+};
+
+inline constexpr InstructionDefinition INSTRUCTION_TABLE[] = {
+    {"ABA", 0x1B, 1, AddressingMode::IMPLIED, 2},
+    {"ADCA", 0x89, 2, AddressingMode::IMMEDIATE, 2},
+    {"ADCA", 0x99, 2, AddressingMode::DIRECT, 3},
+    {"ADCA", 0xA9, 2, AddressingMode::INDEXED, 5},
+    {"ADCA", 0xB9, 3, AddressingMode::EXTENDED, 4},
+    {"ADCB", 0xC9, 2, AddressingMode::IMMEDIATE, 2},
+    {"ADCB", 0xD9, 2, AddressingMode::DIRECT, 3},
+    {"ADCB", 0xE9, 2, AddressingMode::INDEXED, 5},
+    {"ADCB", 0xF9, 3, AddressingMode::EXTENDED, 4},
+    {"ADDA", 0x8B, 2, AddressingMode::IMMEDIATE, 2},
+    {"ADDA", 0x9B, 2, AddressingMode::DIRECT, 3},
+    {"ADDA", 0xAB, 2, AddressingMode::INDEXED, 5},
+    {"ADDA", 0xBB, 3, AddressingMode::EXTENDED, 4},
+    {"ADDB", 0xCB, 2, AddressingMode::IMMEDIATE, 2},
+    {"ADDB", 0xDB, 2, AddressingMode::DIRECT, 3},
+    {"ADDB", 0xEB, 2, AddressingMode::INDEXED, 5},
+    {"ADDB", 0xFB, 3, AddressingMode::EXTENDED, 4},
+    {"ANDA", 0x84, 2, AddressingMode::IMMEDIATE, 2},
+    {"ANDA", 0x94, 2, AddressingMode::DIRECT, 3},
+    {"ANDA", 0xA4, 2, AddressingMode::INDEXED, 5},
+    {"ANDA", 0xB4, 3, AddressingMode::EXTENDED, 4},
+    {"ANDB", 0xC4, 2, AddressingMode::IMMEDIATE, 2},
+    {"ANDB", 0xD4, 2, AddressingMode::DIRECT, 3},
+    {"ANDB", 0xE4, 2, AddressingMode::INDEXED, 5},
+    {"ANDB", 0xF4, 3, AddressingMode::EXTENDED, 4},
+    {"ASL", 0x68, 2, AddressingMode::INDEXED, 7},
+    {"ASL", 0x78, 3, AddressingMode::EXTENDED, 6},
+    {"ASLA", 0x48, 1, AddressingMode::IMPLIED, 2},
+    {"ASLB", 0x58, 1, AddressingMode::IMPLIED, 2},
+    {"ASR", 0x67, 2, AddressingMode::INDEXED, 7},
+    {"ASR", 0x77, 3, AddressingMode::EXTENDED, 6},
+    {"ASRA", 0x47, 1, AddressingMode::IMPLIED, 2},
+    {"ASRB", 0x57, 1, AddressingMode::IMPLIED, 2},
+    {"BCC", 0x24, 2, AddressingMode::RELATIVE, 4},
+    {"BCS", 0x25, 2, AddressingMode::RELATIVE, 4},
+    {"BEQ", 0x27, 2, AddressingMode::RELATIVE, 4},
+    {"BGE", 0x2C, 2, AddressingMode::RELATIVE, 4},
+    {"BGT", 0x2E, 2, AddressingMode::RELATIVE, 4},
+    {"BHI", 0x22, 2, AddressingMode::RELATIVE, 4},
+    {"BITA", 0x85, 2, AddressingMode::IMMEDIATE, 2},
+    {"BITA", 0x95, 2, AddressingMode::DIRECT, 3},
+    {"BITA", 0xA5, 2, AddressingMode::INDEXED, 5},
+    {"BITA", 0xB5, 3, AddressingMode::EXTENDED, 4},
+    {"BITB", 0xC5, 2, AddressingMode::IMMEDIATE, 2},
+    {"BITB", 0xD5, 2, AddressingMode::DIRECT, 3},
+    {"BITB", 0xE5, 2, AddressingMode::INDEXED, 5},
+    {"BITB", 0xF5, 3, AddressingMode::EXTENDED, 4},
+    {"BLE", 0x2F, 2, AddressingMode::RELATIVE, 4},
+    {"BLS", 0x23, 2, AddressingMode::RELATIVE, 4},
+    {"BLT", 0x2D, 2, AddressingMode::RELATIVE, 4},
+    {"BMI", 0x2B, 2, AddressingMode::RELATIVE, 4},
+    {"BNE", 0x26, 2, AddressingMode::RELATIVE, 4},
+    {"BPL", 0x2A, 2, AddressingMode::RELATIVE, 4},
+    {"BRA", 0x20, 2, AddressingMode::RELATIVE, 4},
+    {"BSR", 0x8D, 2, AddressingMode::RELATIVE, 8},
+    {"BVC", 0x28, 2, AddressingMode::RELATIVE, 4},
+    {"BVS", 0x29, 2, AddressingMode::RELATIVE, 4},
+    {"CBA", 0x11, 1, AddressingMode::IMPLIED, 2},
+    {"CLC", 0x0C, 1, AddressingMode::IMPLIED, 2},
+    {"CLI", 0x0E, 1, AddressingMode::IMPLIED, 2},
+    {"CLR", 0x6F, 2, AddressingMode::INDEXED, 7},
+    {"CLR", 0x7F, 3, AddressingMode::EXTENDED, 6},
+    {"CLRA", 0x4F, 1, AddressingMode::IMPLIED, 2},
+    {"CLRB", 0x5F, 1, AddressingMode::IMPLIED, 2},
+    {"CLV", 0x0A, 1, AddressingMode::IMPLIED, 2},
+    {"CMPA", 0x81, 2, AddressingMode::IMMEDIATE, 2},
+    {"CMPA", 0x91, 2, AddressingMode::DIRECT, 3},
+    {"CMPA", 0xA1, 2, AddressingMode::INDEXED, 5},
+    {"CMPA", 0xB1, 3, AddressingMode::EXTENDED, 4},
+    {"CMPB", 0xC1, 2, AddressingMode::IMMEDIATE, 2},
+    {"CMPB", 0xD1, 2, AddressingMode::DIRECT, 3},
+    {"CMPB", 0xE1, 2, AddressingMode::INDEXED, 5},
+    {"CMPB", 0xF1, 3, AddressingMode::EXTENDED, 4},
+    {"COM", 0x63, 2, AddressingMode::INDEXED, 7},
+    {"COM", 0x73, 3, AddressingMode::EXTENDED, 6},
+    {"COMA", 0x43, 1, AddressingMode::IMPLIED, 2},
+    {"COMB", 0x53, 1, AddressingMode::IMPLIED, 2},
+    {"CPX", 0x8C, 3, AddressingMode::IMMEDIATE, 3},
+    {"CPX", 0x9C, 2, AddressingMode::DIRECT, 4},
+    {"CPX", 0xAC, 2, AddressingMode::INDEXED, 6},
+    {"CPX", 0xBC, 3, AddressingMode::EXTENDED, 5},
+    {"DAA", 0x19, 1, AddressingMode::IMPLIED, 2},
+    {"DEC", 0x6A, 2, AddressingMode::INDEXED, 7},
+    {"DEC", 0x7A, 3, AddressingMode::EXTENDED, 6},
+    {"DECA", 0x4A, 1, AddressingMode::IMPLIED, 2},
+    {"DECB", 0x5A, 1, AddressingMode::IMPLIED, 2},
+    {"DES", 0x34, 1, AddressingMode::IMPLIED, 4},
+    {"DEX", 0x09, 1, AddressingMode::IMPLIED, 4},
+    {"EORA", 0x88, 2, AddressingMode::IMMEDIATE, 2},
+    {"EORA", 0x98, 2, AddressingMode::DIRECT, 3},
+    {"EORA", 0xA8, 2, AddressingMode::INDEXED, 5},
+    {"EORA", 0xB8, 3, AddressingMode::EXTENDED, 4},
+    {"EORB", 0xC8, 2, AddressingMode::IMMEDIATE, 2},
+    {"EORB", 0xD8, 2, AddressingMode::DIRECT, 3},
+    {"EORB", 0xE8, 2, AddressingMode::INDEXED, 5},
+    {"EORB", 0xF8, 3, AddressingMode::EXTENDED, 4},
+    {"INC", 0x6C, 2, AddressingMode::INDEXED, 7},
+    {"INC", 0x7C, 3, AddressingMode::EXTENDED, 6},
+    {"INCA", 0x4C, 1, AddressingMode::IMPLIED, 2},
+    {"INCB", 0x5C, 1, AddressingMode::IMPLIED, 2},
+    {"INS", 0x31, 1, AddressingMode::IMPLIED, 4},
+    {"INX", 0x08, 1, AddressingMode::IMPLIED, 4},
+    {"JMP", 0x6E, 2, AddressingMode::INDEXED, 4},
+    {"JMP", 0x7E, 3, AddressingMode::EXTENDED, 3},
+    {"JSR", 0xAD, 2, AddressingMode::INDEXED, 8},
+    {"JSR", 0xBD, 3, AddressingMode::EXTENDED, 9},
+    {"LDAA", 0x86, 2, AddressingMode::IMMEDIATE, 2},
+    {"LDAA", 0x96, 2, AddressingMode::DIRECT, 3},
+    {"LDAA", 0xA6, 2, AddressingMode::INDEXED, 5},
+    {"LDAA", 0xB6, 3, AddressingMode::EXTENDED, 4},
+    {"LDAB", 0xC6, 2, AddressingMode::IMMEDIATE, 2},
+    {"LDAB", 0xD6, 2, AddressingMode::DIRECT, 3},
+    {"LDAB", 0xE6, 2, AddressingMode::INDEXED, 5},
+    {"LDAB", 0xF6, 3, AddressingMode::EXTENDED, 4},
+    {"LDS", 0x8E, 3, AddressingMode::IMMEDIATE, 3},
+    {"LDS", 0x9E, 2, AddressingMode::DIRECT, 4},
+    {"LDS", 0xAE, 2, AddressingMode::INDEXED, 6},
+    {"LDS", 0xBE, 3, AddressingMode::EXTENDED, 5},
+    {"LDX", 0xCE, 3, AddressingMode::IMMEDIATE, 3},
+    {"LDX", 0xDE, 2, AddressingMode::DIRECT, 4},
+    {"LDX", 0xEE, 2, AddressingMode::INDEXED, 6},
+    {"LDX", 0xFE, 3, AddressingMode::EXTENDED, 5},
+    {"LSR", 0x64, 2, AddressingMode::INDEXED, 7},
+    {"LSR", 0x74, 3, AddressingMode::EXTENDED, 6},
+    {"LSRA", 0x44, 1, AddressingMode::IMPLIED, 2},
+    {"LSRB", 0x54, 1, AddressingMode::IMPLIED, 2},
+    {"NEG", 0x60, 2, AddressingMode::INDEXED, 7},
+    {"NEG", 0x70, 3, AddressingMode::EXTENDED, 6},
+    {"NEGA", 0x40, 1, AddressingMode::IMPLIED, 2},
+    {"NEGB", 0x50, 1, AddressingMode::IMPLIED, 2},
+    {"NOP", 0x01, 1, AddressingMode::IMPLIED, 2},
+    {"ORAA", 0x8A, 2, AddressingMode::IMMEDIATE, 2},
+    {"ORAA", 0x9A, 2, AddressingMode::DIRECT, 3},
+    {"ORAA", 0xAA, 2, AddressingMode::INDEXED, 5},
+    {"ORAA", 0xBA, 3, AddressingMode::EXTENDED, 4},
+    {"ORAB", 0xCA, 2, AddressingMode::IMMEDIATE, 2},
+    {"ORAB", 0xDA, 2, AddressingMode::DIRECT, 3},
+    {"ORAB", 0xEA, 2, AddressingMode::INDEXED, 5},
+    {"ORAB", 0xFA, 3, AddressingMode::EXTENDED, 4},
+    {"PSHA", 0x36, 1, AddressingMode::IMPLIED, 4},
+    {"PSHB", 0x37, 1, AddressingMode::IMPLIED, 4},
+    {"PULA", 0x32, 1, AddressingMode::IMPLIED, 4},
+    {"PULB", 0x33, 1, AddressingMode::IMPLIED, 4},
+    {"ROL", 0x69, 2, AddressingMode::INDEXED, 7},
+    {"ROL", 0x79, 3, AddressingMode::EXTENDED, 6},
+    {"ROLA", 0x49, 1, AddressingMode::IMPLIED, 2},
+    {"ROLB", 0x59, 1, AddressingMode::IMPLIED, 2},
+    {"ROR", 0x66, 2, AddressingMode::INDEXED, 7},
+    {"ROR", 0x76, 3, AddressingMode::EXTENDED, 6},
+    {"RORA", 0x46, 1, AddressingMode::IMPLIED, 2},
+    {"RORB", 0x56, 1, AddressingMode::IMPLIED, 2},
+    {"RTI", 0x3B, 1, AddressingMode::IMPLIED, 10},
+    {"RTS", 0x39, 1, AddressingMode::IMPLIED, 5},
+    {"SBA", 0x10, 1, AddressingMode::IMPLIED, 2},
+    {"SBCA", 0x82, 2, AddressingMode::IMMEDIATE, 2},
+    {"SBCA", 0x92, 2, AddressingMode::DIRECT, 3},
+    {"SBCA", 0xA2, 2, AddressingMode::INDEXED, 5},
+    {"SBCA", 0xB2, 3, AddressingMode::EXTENDED, 4},
+    {"SBCB", 0xC2, 2, AddressingMode::IMMEDIATE, 2},
+    {"SBCB", 0xD2, 2, AddressingMode::DIRECT, 3},
+    {"SBCB", 0xE2, 2, AddressingMode::INDEXED, 5},
+    {"SBCB", 0xF2, 3, AddressingMode::EXTENDED, 4},
+    {"SEC", 0x0D, 1, AddressingMode::IMPLIED, 2},
+    {"SEI", 0x0F, 1, AddressingMode::IMPLIED, 2},
+    {"SEV", 0x0B, 1, AddressingMode::IMPLIED, 2},
+    {"STAA", 0x97, 2, AddressingMode::DIRECT, 4},
+    {"STAA", 0xA7, 2, AddressingMode::INDEXED, 6},
+    {"STAA", 0xB7, 3, AddressingMode::EXTENDED, 5},
+    {"STAB", 0xD7, 2, AddressingMode::DIRECT, 4},
+    {"STAB", 0xE7, 2, AddressingMode::INDEXED, 6},
+    {"STAB", 0xF7, 3, AddressingMode::EXTENDED, 5},
+    {"STS", 0x9F, 2, AddressingMode::DIRECT, 5},
+    {"STS", 0xAF, 2, AddressingMode::INDEXED, 7},
+    {"STS", 0xBF, 3, AddressingMode::EXTENDED, 6},
+    {"STX", 0xDF, 2, AddressingMode::DIRECT, 5},
+    {"STX", 0xEF, 2, AddressingMode::INDEXED, 7},
+    {"STX", 0xFF, 3, AddressingMode::EXTENDED, 6},
+    {"SUBA", 0x80, 2, AddressingMode::IMMEDIATE, 2},
+    {"SUBA", 0x90, 2, AddressingMode::DIRECT, 3},
+    {"SUBA", 0xA0, 2, AddressingMode::INDEXED, 5},
+    {"SUBA", 0xB0, 3, AddressingMode::EXTENDED, 4},
+    {"SUBB", 0xC0, 2, AddressingMode::IMMEDIATE, 2},
+    {"SUBB", 0xD0, 2, AddressingMode::DIRECT, 3},
+    {"SUBB", 0xE0, 2, AddressingMode::INDEXED, 5},
+    {"SUBB", 0xF0, 3, AddressingMode::EXTENDED, 4},
+    {"SWI", 0x3F, 1, AddressingMode::IMPLIED, 12},
+    {"TAB", 0x16, 1, AddressingMode::IMPLIED, 2},
+    {"TAP", 0x06, 1, AddressingMode::IMPLIED, 2},
+    {"TBA", 0x17, 1, AddressingMode::IMPLIED, 2},
+    {"TPA", 0x07, 1, AddressingMode::IMPLIED, 2},
+    {"TST", 0x6D, 2, AddressingMode::INDEXED, 7},
+    {"TST", 0x7D, 3, AddressingMode::EXTENDED, 6},
+    {"TSTA", 0x4D, 1, AddressingMode::IMPLIED, 2},
+    {"TSTB", 0x5D, 1, AddressingMode::IMPLIED, 2},
+    {"TSX", 0x30, 1, AddressingMode::IMPLIED, 4},
+    {"TXS", 0x35, 1, AddressingMode::IMPLIED, 4},
+    {"WAI", 0x3E, 1, AddressingMode::IMPLIED, 9},
+};
+
+#endif // INSTRUCTION_TABLE_HPP
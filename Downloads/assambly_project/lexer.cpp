@@ -0,0 +1,89 @@
+#include "lexer.hpp"
+
+namespace {
+
+// std::regex'teki \w ve \s ile aynı karakter sınıfları (locale'den bağımsız)
+inline bool is_word_char(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+inline bool is_space_char(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+} // namespace
+
+bool lex_line(std::string_view line, LexedLine& out) {
+    out = LexedLine();
+
+    // Yorum ';' ile başlar; kalan kısım iki uçtan kırpılır
+    size_t end = line.find(';');
+    if (end == std::string_view::npos) end = line.size();
+    size_t pos = 0;
+    while (pos < end && is_space_char(line[pos])) ++pos;
+    while (end > pos && is_space_char(line[end - 1])) --end;
+    out.statement = line.substr(pos, end - pos);
+    if (pos == end) return true;
+
+    auto skip_spaces = [&](size_t p) { while (p < end && is_space_char(line[p])) ++p; return p; };
+    auto word_end = [&](size_t p) { while (p < end && is_word_char(line[p])) ++p; return p; };
+    // En fazla iki '#' / '$' önekinden sonraki kelimenin sonu (değer yoksa p'nin kendisi)
+    auto value_end = [&](size_t p) {
+        for (int i = 0; i < 2 && p < end && (line[p] == '#' || line[p] == '$'); ++i) ++p;
+        size_t e = word_end(p);
+        return e == p ? std::string_view::npos : e;
+    };
+    auto token = [&](size_t from, size_t to) { return LexToken{line.substr(from, to - from), static_cast<int>(from) + 1}; };
+    auto fail = [&](size_t at) { out.error_column = static_cast<int>(at) + 1; return false; };
+
+    // [etiket:] mnemonic
+    size_t word = word_end(pos);
+    if (word == pos) return fail(pos);
+    if (word < end && line[word] == ':') {
+        out.label = token(pos, word);
+        pos = skip_spaces(word + 1);
+        if (pos == end) return true; // Sadece etiket tanımı
+        word = word_end(pos);
+        if (word == pos) return fail(pos);
+    }
+    out.mnemonic = token(pos, word);
+    pos = skip_spaces(word);
+    if (pos == end) return true;
+
+    // Birinci operand: [#$]{0,2}kelime [, kelime]
+    const size_t first_start = pos;
+    size_t first_end = value_end(pos);
+    if (first_end == std::string_view::npos) return fail(pos);
+    LexToken first = token(first_start, first_end);
+    LexToken tail, second;
+    pos = skip_spaces(first_end);
+    if (pos < end && line[pos] == ',') {
+        size_t tail_start = skip_spaces(pos + 1);
+        size_t tail_end = word_end(tail_start);
+        if (tail_end > tail_start) {
+            tail = token(tail_start, tail_end);
+            first_end = tail_end;
+            pos = skip_spaces(tail_end);
+        }
+    }
+    // İkinci operand: , [#$]{0,2}kelime
+    if (pos < end && line[pos] == ',') {
+        size_t second_start = skip_spaces(pos + 1);
+        size_t second_end = value_end(second_start);
+        if (second_end == std::string_view::npos) return fail(second_start);
+        second = token(second_start, second_end);
+        pos = skip_spaces(second_end);
+    }
+    if (pos != end) return fail(pos);
+
+    if (!second.empty()) {
+        out.register_operand = token(first_start, first_end);
+        out.value_operand = second;
+    } else if (!tail.empty()) {
+        out.register_operand = first;
+        out.value_operand = tail;
+    } else {
+        out.value_operand = first;
+    }
+    return true;
+}
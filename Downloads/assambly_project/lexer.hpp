@@ -0,0 +1,31 @@
+#ifndef LEXER_HPP
+#define LEXER_HPP
+
+#include <string_view>
+
+// Kaynak satırındaki bir parça. text satırın içini gösterir (kopya yapılmaz);
+// column 1'den başlar, parça yoksa 0'dır.
+struct LexToken {
+    std::string_view text;
+    int column = 0;
+
+    bool empty() const { return text.empty(); }
+};
+
+// Tek satırın parçaları. Kabul edilen biçim eski regex ile aynıdır:
+//   [etiket:] mnemonic [[#|$]{0,2}değer [, kelime]] [, [#|$]{0,2}değer] [; yorum]
+// "A,B" biçimindeki operandın ilk kısmı register, son kısmı value olur; tek operand value'dur.
+struct LexedLine {
+    LexToken label;
+    LexToken mnemonic;
+    LexToken register_operand;   // "0,X" -> "0"; "A,B,#C" -> "A,B"
+    LexToken value_operand;      // "0,X" -> "X"; "#$10" -> "#$10"
+    std::string_view statement;  // Yorumsuz ve kırpılmış satır (listeleme için)
+    int error_column = 0;        // Sözdizimi hatasının başladığı sütun (hata yoksa 0)
+};
+
+// Satırı tek geçişte parçalar; bellek ayırmaz. Boş veya sadece yorum olan satır için
+// statement boştur ve true döner. Sözdizimi hatasında false döner ve error_column kurulur.
+bool lex_line(std::string_view line, LexedLine& out);
+
+#endif // LEXER_HPP
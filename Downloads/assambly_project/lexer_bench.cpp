@@ -0,0 +1,132 @@
+// Satır ayrıştırıcı karşılaştırması: eski std::regex yolu ile lex_line.
+//
+// Kullanım: lexer_bench [satır_sayısı]   (varsayılan 1000000)
+// Derleme: g++ -std=c++17 -O2 lexer_bench.cpp lexer.cpp -o lexer_bench
+//
+// Rastgele ama tekrarlanabilir (sabit tohumlu) bir kaynak bellekte üretilir; her iki
+// yol da aynı satırları parçalar, saniyedeki satır sayısı yazılır ve sonuçlar
+// (etiket, mnemonic, register ve değer operandı) satır satır karşılaştırılır.
+
+#include "lexer.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+// assembler.cpp'nin lexer'dan önce kullandığı desen ve son işlemler
+const std::regex LEGACY_PATTERN("^\\s*(?:(\\w+):\\s*)?(\\w+)\\s*(?:([#$]?[#$]?\\w+(?:\\s*,\\s*\\w+)?)(?:\\s*,\\s*([#$]?[#$]?\\w+))?)?(?:\\s*;\\s*(.*))?$");
+
+std::string trim(const std::string& str) {
+    const std::string whitespace = " \t\n\r\f\v";
+    const auto begin = str.find_first_not_of(whitespace);
+    if (begin == std::string::npos) return "";
+    const auto end = str.find_last_not_of(whitespace);
+    return str.substr(begin, end - begin + 1);
+}
+
+struct Fields {
+    std::string label, mnemonic, register_operand, value_operand;
+    bool ok = false;
+};
+
+Fields legacy_parse(std::string line) {
+    Fields f;
+    if (line.find(';') != std::string::npos) line = line.substr(0, line.find(';'));
+    std::string processed = trim(line);
+    std::smatch matches;
+    if (processed.empty() || !std::regex_match(processed, matches, LEGACY_PATTERN)) return f;
+    f.ok = true;
+    f.label = trim(matches[1].str());
+    f.mnemonic = trim(matches[2].str());
+    std::string operand1 = trim(matches[3].str());
+    std::string operand2 = trim(matches[4].str());
+    if (!operand2.empty()) {
+        f.register_operand = operand1;
+        f.value_operand = operand2;
+    } else if (!operand1.empty()) {
+        size_t comma = operand1.find(',');
+        if (comma != std::string::npos) {
+            f.register_operand = trim(operand1.substr(0, comma));
+            f.value_operand = trim(operand1.substr(comma + 1));
+        } else {
+            f.value_operand = operand1;
+        }
+    }
+    return f;
+}
+
+std::vector<std::string> make_source(size_t count) {
+    static const char* const MNEMONICS[] = {"LDAA", "STAA", "ADDA", "LDX", "INCA", "NOP", "BNE", "JSR", "CMPB", "ANDA"};
+    static const char* const OPERANDS[] = {"#$0E", "$0200", "$51", "0,X", "#10", "LOOP", "$FF , X", "A,B,#$10", "#$$1F", ""};
+    std::mt19937 rng(12345);
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string line;
+        if (rng() % 8 == 0) line += "L" + std::to_string(i) + ": ";
+        else line += (rng() % 2) ? "    " : "\t";
+        line += MNEMONICS[rng() % 10];
+        const char* operand = OPERANDS[rng() % 10];
+        if (*operand) { line += ' '; line += operand; }
+        if (rng() % 4 == 0) line += "   ; yorum satiri " + std::to_string(i);
+        if (rng() % 64 == 0) line += " fazla";  // Sözdizimi hatası
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+template <typename Fn>
+double lines_per_second(const std::vector<std::string>& lines, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& line : lines) fn(line);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return lines.size() / seconds;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    if (count == 0) {
+        std::cerr << "Kullanim: " << argv[0] << " [satir_sayisi]" << std::endl;
+        return 1;
+    }
+    const std::vector<std::string> lines = make_source(count);
+
+    size_t legacy_ok = 0, lexer_ok = 0;
+    double legacy_rate = lines_per_second(lines, [&](const std::string& line) {
+        if (legacy_parse(line).ok) legacy_ok++;
+    });
+    double lexer_rate = lines_per_second(lines, [&](const std::string& line) {
+        LexedLine lexed;
+        if (lex_line(line, lexed) && !lexed.statement.empty()) lexer_ok++;
+    });
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        Fields expected = legacy_parse(lines[i]);
+        LexedLine lexed;
+        bool ok = lex_line(lines[i], lexed) && !lexed.statement.empty();
+        bool same = (ok == expected.ok);
+        if (same && ok) {
+            same = lexed.label.text == expected.label && lexed.mnemonic.text == expected.mnemonic
+                && lexed.register_operand.text == expected.register_operand
+                && lexed.value_operand.text == expected.value_operand;
+        }
+        if (!same && mismatches++ < 5) {
+            std::cerr << "Fark (satir " << i + 1 << "): '" << lines[i] << "'" << std::endl;
+        }
+    }
+
+    std::cout << lines.size() << " satir (" << legacy_ok << " regex / " << lexer_ok << " lexer gecerli)\n"
+              << "std::regex : " << static_cast<uint64_t>(legacy_rate) << " satir/sn\n"
+              << "lex_line   : " << static_cast<uint64_t>(lexer_rate) << " satir/sn ("
+              << lexer_rate / legacy_rate << "x)\n"
+              << "Farkli sonuc: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 2;
+}
@@ -0,0 +1,214 @@
+// Bağlayıcı: yeniden konumlandırılabilir modülleri (.rel) tek bir mutlak görüntüde birleştirir.
+//
+// Kullanım: linker <çıktı> <girdi>... [--base=BÖLÜM=$adres] [--entry=SEMBOL] [--format=bits|raw|s19|hex]
+//                  [--threads=N] [--rebuild]
+// Derleme: g++ -std=c++17 -O2 -pthread linker.cpp assembler.cpp lexer.cpp listing.cpp source_file.cpp object_format.cpp object_module.cpp set_initializer.cpp trace.cpp -o linker
+//
+// Girdiler .rel modülleri veya .asm kaynaklarıdır. Kaynaklar ayrı iş parçacıklarında,
+// her biri kendi AssemblyContext'iyle derlenir ve modülleri yanlarına .rel olarak yazılır;
+// .rel kaynaktan daha yeniyse kaynak yeniden derlenmez (--rebuild hepsini derletir).
+// Modüller komut satırındaki sırayla bağlanır:
+//
+//   linker program.s19 main.asm lib/print.asm --base=CODE=$1000 --base=DATA=$0080
+//
+//   --base       Bölümün başlangıç adresi; verilmeyen bölümler bir öncekinin arkasına,
+//                ilki $0100'e yerleşir
+//   --entry      S19 / Intel HEX başlangıç adresi olarak XDEF edilmiş bir sembol
+//                (varsayılan: ilk ORG'lu modül, o da yoksa ilk bölüm)
+
+#include "assembler.hpp"
+#include "object_format.hpp"
+#include "object_module.hpp"
+#include "set_initializer.hpp"
+#include "source_file.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct ModuleJob {
+    std::filesystem::path input;
+    std::filesystem::path module_path; // .asm girdisinin .rel dosyası (girdi .rel ise kendisi)
+    bool is_source = false;
+    bool assembled = false;            // false: .rel dosyadan okundu
+    bool ok = false;
+    std::string messages;              // Derleme mesajları veya okuma hatası
+    ObjectModule module;
+};
+
+// "$1F", "0x1F" veya ondalık; geçersizse boş
+std::optional<uint32_t> parse_number(const std::string& text) {
+    try {
+        size_t used = 0;
+        unsigned long value;
+        if (!text.empty() && text[0] == '$') {
+            value = std::stoul(text.substr(1), &used, 16);
+            used += 1;
+        } else if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+            value = std::stoul(text.substr(2), &used, 16);
+            used += 2;
+        } else {
+            value = std::stoul(text, &used, 10);
+        }
+        if (used != text.size() || value > 0xFFFF) return std::nullopt;
+        return static_cast<uint32_t>(value);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+bool read_file(const std::filesystem::path& path, std::string& text, std::string& error) {
+    MappedFile file;
+    if (!file.open(path.string(), error)) return false;
+    text.assign(file.text());
+    return true;
+}
+
+// Kaynak değişmemişse (modül dosyası ondan yeni) önceki .rel kullanılır
+bool module_is_current(const ModuleJob& job) {
+    std::error_code error;
+    auto module_time = std::filesystem::last_write_time(job.module_path, error);
+    if (error) return false;
+    auto source_time = std::filesystem::last_write_time(job.input, error);
+    return !error && module_time >= source_time;
+}
+
+void load_module(const InstructionSet& instruction_set, bool rebuild, ModuleJob& job) {
+    std::string text, error;
+    if (job.is_source && (rebuild || !module_is_current(job))) {
+        job.assembled = true;
+        MappedFile source;
+        if (!source.open(job.input.string(), error)) {
+            job.messages = "kaynak acilamadi: " + error + "\n";
+            return;
+        }
+        std::ostringstream diagnostics; // Mesajlar iş parçacıkları karışmasın diye sonra sırayla yazılır
+        AssemblyContext ctx(instruction_set, diagnostics);
+        assemble_buffer(ctx, source.text());
+        job.messages = diagnostics.str();
+        if (ctx.error_count > 0) return;
+        build_module(ctx, job.input.stem().string(), job.module);
+        std::ofstream out(job.module_path);
+        if (!out.is_open() || !write_module(out, job.module)) {
+            job.messages += "modul dosyasi '" + job.module_path.string() + "' yazilamadi\n";
+            return;
+        }
+        job.ok = true;
+        return;
+    }
+    if (!read_file(job.module_path, text, error)) {
+        job.messages = "modul acilamadi: " + error + "\n";
+        return;
+    }
+    job.ok = read_module(text.data(), text.size(), job.module, error);
+    if (!job.ok) job.messages = error + "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+    bool rebuild = false;
+    LinkOptions options;
+    ObjectFormat output_format = ObjectFormat::AUTO;
+    std::vector<ModuleJob> jobs;
+    bool arguments_ok = (argc >= 3);
+    for (int i = 2; i < argc && arguments_ok; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--base=", 0) == 0) {
+            size_t equals = arg.find('=', 7);
+            auto address = (equals == std::string::npos) ? std::nullopt : parse_number(arg.substr(equals + 1));
+            arguments_ok = address.has_value() && equals > 7;
+            if (arguments_ok) options.section_bases.emplace_back(arg.substr(7, equals - 7), static_cast<uint16_t>(address.value()));
+        } else if (arg.rfind("--entry=", 0) == 0) {
+            options.entry_symbol = arg.substr(8);
+            arguments_ok = !options.entry_symbol.empty();
+        } else if (arg.rfind("--format=", 0) == 0) {
+            output_format = object_format_from_name(arg.substr(9));
+            arguments_ok = (output_format != ObjectFormat::AUTO && output_format != ObjectFormat::RELOCATABLE);
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            auto count = parse_number(arg.substr(10));
+            arguments_ok = count.has_value() && count.value() > 0;
+            if (arguments_ok) thread_count = count.value();
+        } else if (arg == "--rebuild") {
+            rebuild = true;
+        } else if (arg.rfind("--", 0) == 0) {
+            arguments_ok = false; // Geçersiz seçenek: kullanım mesajını göster
+        } else {
+            ModuleJob job;
+            job.input = arg;
+            job.is_source = (job.input.extension() != ".rel");
+            job.module_path = job.input;
+            if (job.is_source) job.module_path.replace_extension(".rel");
+            jobs.push_back(std::move(job));
+        }
+    }
+    if (!arguments_ok || jobs.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <output_file> <module.rel|source.asm>... [--base=SECTION=$addr] [--entry=SYMBOL]"
+                  << " [--format=bits|raw|s19|hex] [--threads=N] [--rebuild]" << std::endl;
+        return 1;
+    }
+    set_trace_level(TraceLevel::OFF); // Derleyici listelemesi kapalı
+
+    InstructionSet instruction_set;
+    set_initializer(instruction_set);
+
+    // Modüller birbirinden bağımsızdır; paylaşılan tek durum salt okunur komut setidir
+    std::atomic<size_t> next_job{0};
+    std::vector<std::thread> workers;
+    thread_count = std::min(thread_count, jobs.size());
+    for (size_t worker = 0; worker < thread_count; ++worker) {
+        workers.emplace_back([&]() {
+            for (size_t job = next_job++; job < jobs.size(); job = next_job++) {
+                load_module(instruction_set, rebuild, jobs[job]);
+            }
+        });
+    }
+    for (auto& thread : workers) thread.join();
+
+    bool all_ok = true;
+    size_t assembled = 0;
+    std::vector<ObjectModule> modules;
+    for (ModuleJob& job : jobs) {
+        if (!job.messages.empty()) std::cerr << job.input.string() << ":\n" << job.messages;
+        if (job.assembled) assembled++;
+        all_ok = all_ok && job.ok;
+        modules.push_back(std::move(job.module));
+    }
+    if (!all_ok) {
+        std::cerr << "HATA: Modul hatalari nedeniyle baglama yapilmadi." << std::endl;
+        return 2;
+    }
+
+    ObjectImage image;
+    std::vector<std::string> errors;
+    if (!link_modules(modules, options, image, errors)) {
+        for (const std::string& error : errors) std::cerr << "Link error: " << error << std::endl;
+        return 2;
+    }
+
+    std::string output_filename = argv[1];
+    if (output_format == ObjectFormat::AUTO) output_format = object_format_from_extension(output_filename);
+    if (output_format == ObjectFormat::RELOCATABLE) { // Bağlanmış görüntü mutlaktır
+        std::cerr << "HATA: Cikti '" << output_filename << "' icin --format=bits|raw|s19|hex secilmeli." << std::endl;
+        return 1;
+    }
+    std::ofstream outfile(output_filename, output_format == ObjectFormat::RAW ? std::ios::binary : std::ios::out);
+    if (!outfile.is_open() || !write_object(outfile, output_format, image.data, image.segments, image.entry)) {
+        std::cerr << "HATA: Cikti dosyasi '" << output_filename << "' yazilamadi!" << std::endl;
+        return 1;
+    }
+    std::cout << modules.size() << " modul (" << assembled << " derlendi, " << (modules.size() - assembled)
+              << " degismedi) baglandi: " << image.data.size() << " bytes, " << image.segments.size()
+              << " bolum -> " << output_filename << std::endl;
+    return 0;
+}
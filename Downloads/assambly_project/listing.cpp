@@ -0,0 +1,223 @@
+#include "listing.hpp"
+#include "text_format.hpp"
+#include <algorithm>
+#include <climits>
+#include <ostream>
+
+namespace {
+
+// Sağa hizalı ondalık sayı
+void append_decimal(std::string& out, long long value, size_t width) {
+    std::string digits = std::to_string(value);
+    if (digits.size() < width) out.append(width - digits.size(), ' ');
+    out += digits;
+}
+
+void append_padded(std::string& out, std::string_view text, size_t width) {
+    out.append(text.data(), text.size());
+    if (text.size() < width) out.append(width - text.size(), ' ');
+}
+
+// Satırın altına yazılan mesaj: "        ** error, col 5: ..." (sütun bilinmiyorsa yazılmaz)
+void append_diagnostic(std::string& out, const AssemblyDiagnostic& message) {
+    out += "        ** ";
+    out += message.is_error ? "error" : "warning";
+    if (message.column > 0) out += ", col " + std::to_string(message.column);
+    out += ": ";
+    out += message.message;
+    out.push_back('\n');
+}
+
+const char* kind_name(ListingKind kind) {
+    switch (kind) {
+        case ListingKind::INSTRUCTION: return "instruction";
+        case ListingKind::LABEL: return "label";
+        case ListingKind::DIRECTIVE: return "directive";
+        case ListingKind::ERROR: return "error";
+    }
+    return "";
+}
+
+void append_json_section(std::string& out, const AssemblyListing& listing, int section) {
+    if (section < 0 || section >= static_cast<int>(listing.sections.size())) out += "null";
+    else append_json_string(out, listing.sections[section]);
+}
+
+} // namespace
+
+void AssemblyListing::add(int line, int address, int section, size_t offset, const uint8_t* bytes, size_t length,
+                          int cycles, ListingKind kind, std::string_view source, std::string_view label) {
+    ListingEntry entry = {};
+    entry.line = line;
+    entry.address = address;
+    entry.section = section;
+    entry.offset = offset;
+    entry.length = static_cast<uint8_t>(std::min<size_t>(length, sizeof(entry.bytes)));
+    if (bytes != nullptr) std::copy(bytes, bytes + entry.length, entry.bytes);
+    entry.cycles = static_cast<uint8_t>(std::clamp(cycles, 0, 0xFF));
+    entry.kind = kind;
+    entry.source_begin = static_cast<uint32_t>(text.size());
+    entry.source_length = static_cast<uint32_t>(source.size());
+    text.append(source.data(), source.size());
+    entry.label_begin = static_cast<uint32_t>(text.size());
+    entry.label_length = static_cast<uint32_t>(label.size());
+    text.append(label.data(), label.size());
+    lines.push_back(entry);
+}
+
+void AssemblyListing::add_symbol(std::string_view name, int address, int section) {
+    symbols.push_back(ListingSymbol{std::string(name), address, section});
+}
+
+void AssemblyListing::finish(const AssemblyContext& ctx) {
+    // Hatalar satırın kendisinde değil sonradan da bildirilebilir (menzil dışı ileri dallanma,
+    // tanımsız sembol); satırın türü bu yüzden mesajların satır numaralarından belirlenir
+    std::vector<int> error_lines;
+    for (const AssemblyDiagnostic& message : ctx.messages) {
+        if (message.is_error) error_lines.push_back(message.line);
+    }
+    std::sort(error_lines.begin(), error_lines.end());
+    for (ListingEntry& entry : lines) {
+        for (size_t i = 0; i < entry.length && entry.offset + i < ctx.programData.size(); ++i) {
+            entry.bytes[i] = ctx.programData[entry.offset + i];
+        }
+        if (std::binary_search(error_lines.begin(), error_lines.end(), entry.line)) entry.kind = ListingKind::ERROR;
+    }
+    symbols.clear();
+    ctx.symbolTable.for_each_symbol([&](std::string_view name, int address) {
+        add_symbol(name, address, ctx.symbol_section(ctx.symbolTable.find(name)));
+    });
+    std::sort(symbols.begin(), symbols.end(), [](const ListingSymbol& a, const ListingSymbol& b) {
+        return a.address != b.address ? a.address < b.address : a.name < b.name;
+    });
+    sections = ctx.sections;
+    diagnostics = ctx.messages;
+    error_count = ctx.error_count;
+    byte_count = ctx.programData.size();
+}
+
+void AssemblyListing::clear() {
+    lines.clear();
+    text.clear();
+    symbols.clear();
+    sections.clear();
+    diagnostics.clear();
+    error_count = 0;
+    byte_count = 0;
+}
+
+std::string format_listing_text(const AssemblyListing& listing) {
+    std::string out;
+    out.reserve(listing.entries().size() * 64 + 128);
+    // Mesajlar satır numarasına göre sıralanıp ilgili satırın hemen altına yazılır;
+    // satırı olmayanlar (line 0) en sona kalır
+    auto message_line = [](const AssemblyDiagnostic* message) { return message->line > 0 ? message->line : INT_MAX; };
+    std::vector<const AssemblyDiagnostic*> messages;
+    for (const AssemblyDiagnostic& message : listing.diagnostics) messages.push_back(&message);
+    std::stable_sort(messages.begin(), messages.end(), [&](const AssemblyDiagnostic* a, const AssemblyDiagnostic* b) {
+        return message_line(a) < message_line(b);
+    });
+    size_t next_message = 0;
+
+    out += "  LINE  ADDR  BYTES     CYC  LABEL            SOURCE\n";
+    const std::vector<ListingEntry>& entries = listing.entries();
+    for (size_t index = 0; index < entries.size(); ++index) {
+        const ListingEntry& entry = entries[index];
+        out.push_back(entry.kind == ListingKind::ERROR ? '*' : ' '); // Hatalı satır işareti
+        append_decimal(out, entry.line, 5);
+        out += "  ";
+        append_hex(out, static_cast<uint32_t>(entry.address), 4);
+        out += "  ";
+        std::string bytes;
+        for (size_t i = 0; i < entry.length; ++i) {
+            if (i > 0) bytes.push_back(' ');
+            append_hex(bytes, entry.bytes[i], 2);
+        }
+        append_padded(out, bytes, 8);
+        out += "  ";
+        if (entry.cycles > 0) append_decimal(out, entry.cycles, 3);
+        else out += "   ";
+        out += "  ";
+        append_padded(out, listing.label(entry), 16);
+        out.push_back(' ');
+        out += listing.source(entry);
+        if (entry.section >= 0 && entry.section < static_cast<int>(listing.sections.size())) {
+            out += "    [" + listing.sections[entry.section] + "]";
+        }
+        out.push_back('\n');
+        // Aynı satırdan birden çok kayıt olabilir; mesajlar o satırın son kaydından sonra gelir
+        if (index + 1 == entries.size() || entries[index + 1].line != entry.line) {
+            while (next_message < messages.size() && message_line(messages[next_message]) <= entry.line) {
+                append_diagnostic(out, *messages[next_message++]);
+            }
+        }
+    }
+    // Listelenmeyen satırlara veya hiçbir satıra ait olmayan mesajlar
+    while (next_message < messages.size()) append_diagnostic(out, *messages[next_message++]);
+
+    if (!listing.symbols.empty()) {
+        out += "\nSYMBOLS\n";
+        for (const ListingSymbol& symbol : listing.symbols) {
+            out += "  ";
+            append_padded(out, symbol.name, 16);
+            out += " $";
+            append_hex(out, static_cast<uint32_t>(symbol.address), 4);
+            if (symbol.section >= 0 && symbol.section < static_cast<int>(listing.sections.size())) {
+                out += "  [" + listing.sections[symbol.section] + "]";
+            }
+            out.push_back('\n');
+        }
+    }
+    out += "\n" + std::to_string(listing.error_count) + " error(s), " + std::to_string(listing.byte_count) + " bytes\n";
+    return out;
+}
+
+std::string format_listing_json(const AssemblyListing& listing) {
+    std::string out;
+    out.reserve(listing.entries().size() * 128 + 128);
+    out += "{\"lines\":[";
+    bool first = true;
+    for (const ListingEntry& entry : listing.entries()) {
+        out += first ? "\n" : ",\n";
+        first = false;
+        out += "{\"line\":" + std::to_string(entry.line) + ",\"kind\":\"" + kind_name(entry.kind)
+             + "\",\"address\":" + std::to_string(entry.address) + ",\"section\":";
+        append_json_section(out, listing, entry.section);
+        out += ",\"bytes\":\"";
+        for (size_t i = 0; i < entry.length; ++i) append_hex(out, entry.bytes[i], 2);
+        out += "\",\"cycles\":" + std::to_string(entry.cycles) + ",\"label\":";
+        append_json_string(out, listing.label(entry));
+        out += ",\"source\":";
+        append_json_string(out, listing.source(entry));
+        out.push_back('}');
+    }
+    out += "\n],\"symbols\":[";
+    first = true;
+    for (const ListingSymbol& symbol : listing.symbols) {
+        out += first ? "\n" : ",\n";
+        first = false;
+        out += "{\"name\":";
+        append_json_string(out, symbol.name);
+        out += ",\"address\":" + std::to_string(symbol.address) + ",\"section\":";
+        append_json_section(out, listing, symbol.section);
+        out.push_back('}');
+    }
+    out += "\n],\"diagnostics\":[";
+    first = true;
+    for (const AssemblyDiagnostic& message : listing.diagnostics) {
+        out += first ? "\n" : ",\n";
+        first = false;
+        out += "{\"line\":" + std::to_string(message.line) + ",\"column\":" + std::to_string(message.column)
+             + ",\"error\":" + (message.is_error ? "true" : "false") + ",\"message\":";
+        append_json_string(out, message.message);
+        out.push_back('}');
+    }
+    out += "\n],\"error_count\":" + std::to_string(listing.error_count) + "}\n";
+    return out;
+}
+
+bool write_listing(std::ostream& out, const AssemblyListing& listing, bool json) {
+    const std::string text = json ? format_listing_json(listing) : format_listing_text(listing);
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(out);
+}
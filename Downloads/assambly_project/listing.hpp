@@ -0,0 +1,78 @@
+#ifndef LISTING_HPP
+#define LISTING_HPP
+
+#include "assembler.hpp" // AssemblyContext, AssemblyDiagnostic
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class ListingKind : uint8_t {
+    INSTRUCTION,   // Makine kodu üretti
+    LABEL,         // Sadece etiket tanımı
+    DIRECTIVE,     // ORG, END, SECTION, XDEF, XREF
+    ERROR          // Satırda hata bildirildi
+};
+
+// Listelemenin bir satırı. parse() sırasında byte'ların programData'daki yeri tutulur ve
+// finish() ile kopyalanır; böylece sonradan yamalanan (ileri başvuru) operandlar son
+// halleriyle görünür.
+struct ListingEntry {
+    int line;
+    int address;          // Komutun/etiketin adresi; direktiflerde satırdan sonraki LC
+    int section;          // sections() indeksi; -1 mutlak kod
+    size_t offset;        // programData[offset, offset + length) (finish()'ten önce)
+    uint8_t length;
+    uint8_t bytes[4];
+    uint8_t cycles;       // Komut tablosundaki çevrim sayısı (bilinmiyorsa 0)
+    ListingKind kind;
+    uint32_t source_begin;  // Kaynak metni ve etiket adı text arenasında
+    uint32_t source_length;
+    uint32_t label_begin;
+    uint32_t label_length;
+};
+
+struct ListingSymbol {
+    std::string name;
+    int address;
+    int section;
+};
+
+// Yapılandırılmış listeleme. AssemblyContext::listing ayarlıysa parse() her satırı ekler ve
+// finish_assembly() sembolleri ve mesajları kopyalar. Satırlar bellekte biriktirilir ve
+// sonunda tek bir yazma ile aktarılır; konsola yazılan iz çıktısından bağımsızdır.
+class AssemblyListing
+{
+public:
+    // bytes nullptr ise byte'lar finish() sırasında programData[offset...]'ten alınır
+    void add(int line, int address, int section, size_t offset, const uint8_t* bytes, size_t length, int cycles,
+             ListingKind kind, std::string_view source, std::string_view label);
+    void add_symbol(std::string_view name, int address, int section);
+    void finish(const AssemblyContext& ctx);
+    void clear();
+
+    const std::vector<ListingEntry>& entries() const { return lines; }
+    std::string_view source(const ListingEntry& entry) const { return std::string_view(text).substr(entry.source_begin, entry.source_length); }
+    std::string_view label(const ListingEntry& entry) const { return std::string_view(text).substr(entry.label_begin, entry.label_length); }
+
+    std::vector<ListingSymbol> symbols;           // Adrese göre sıralı (finish() sonrası)
+    std::vector<std::string> sections;
+    std::vector<AssemblyDiagnostic> diagnostics;
+    int error_count = 0;
+    size_t byte_count = 0;
+
+private:
+    std::vector<ListingEntry> lines;
+    std::string text;
+};
+
+// Sütunlu metin: SATIR ADRES BYTE'LAR ÇEVRİM ETİKET KAYNAK, ardından sembol tablosu. Hatalı
+// satırlar '*' ile işaretlenir ve satırın mesajları hemen altına yazılır.
+std::string format_listing_text(const AssemblyListing& listing);
+// {"lines":[...],"symbols":[...],"diagnostics":[...],"error_count":N}; her satır kaydı
+// ayrı bir metin satırındadır, araçlar regex kullanmadan bir JSON ayrıştırıcısıyla okur
+std::string format_listing_json(const AssemblyListing& listing);
+bool write_listing(std::ostream& out, const AssemblyListing& listing, bool json);
+
+#endif // LISTING_HPP
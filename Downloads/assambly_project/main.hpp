@@ -1,7 +1,6 @@
-#ifndef REGEX_HPP
-#define REGEX_HPP
+#ifndef MAIN_HPP
+#define MAIN_HPP
 
-#include <regex>
 #include <string>
 #include <iostream>
 #include <optional>
@@ -9,6 +8,12 @@
 #include <cinttypes>
 #include <iomanip>
 #include <fstream>
+#include <string_view>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
 
 using namespace std;
 
@@ -27,46 +32,259 @@ enum class AddressingMode
     // Ama genelde bunlar IMPLIED içinde değerlendirilir.
 };
 
+using SymbolId = uint32_t;
+constexpr SymbolId INVALID_SYMBOL = UINT32_MAX;
+
+// Tanımlayıcıları (etiket adları) tek kopya olarak saklar. Her farklı isim 64KB'lık
+// bloklardan oluşan bir arenaya bir kez kopyalanır ve sıralı bir numara (SymbolId) alır;
+// tablolar string yerine bu numarayla indekslenir. Bloklar hiç taşınmadığı için
+// name() ile dönen string_view'lar interner yaşadıkça geçerlidir.
+class StringInterner
+{
+public:
+    SymbolId intern(std::string_view text)
+    {
+        uint64_t h = hash(text);
+        if (!slots.empty())
+        {
+            for (size_t s = h & (slots.size() - 1); slots[s] != 0; s = (s + 1) & (slots.size() - 1))
+            {
+                SymbolId id = slots[s] - 1;
+                if (hashes[id] == h && names[id] == text) return id;
+            }
+        }
+        if ((names.size() + 1) * 2 > slots.size()) grow();
+
+        SymbolId id = static_cast<SymbolId>(names.size());
+        names.push_back(store(text));
+        hashes.push_back(h);
+        size_t s = h & (slots.size() - 1);
+        while (slots[s] != 0) s = (s + 1) & (slots.size() - 1);
+        slots[s] = id + 1;
+        return id;
+    }
+
+    // Daha önce intern edilmemişse INVALID_SYMBOL döner (yeni girdi eklemez)
+    SymbolId find(std::string_view text) const
+    {
+        if (slots.empty()) return INVALID_SYMBOL;
+        uint64_t h = hash(text);
+        for (size_t s = h & (slots.size() - 1); slots[s] != 0; s = (s + 1) & (slots.size() - 1))
+        {
+            SymbolId id = slots[s] - 1;
+            if (hashes[id] == h && names[id] == text) return id;
+        }
+        return INVALID_SYMBOL;
+    }
+
+    std::string_view name(SymbolId id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+
+    // Tüm isimleri unutur. Yazılmakta olan blok ve tablolar saklanır; sık temizlenen
+    // küçük bir tablo (ör. tek satırlık derleme bağlamı) yeniden bellek ayırmaz.
+    void clear()
+    {
+        std::unique_ptr<char[]> current;
+        if (!blocks.empty() && block_used < BLOCK_SIZE) current = std::move(blocks.back());
+        blocks.clear();
+        block_used = BLOCK_SIZE;
+        if (current)
+        {
+            blocks.push_back(std::move(current));
+            block_used = 0;
+        }
+        names.clear();
+        hashes.clear();
+        std::fill(slots.begin(), slots.end(), 0);
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    static uint64_t hash(std::string_view text)
+    {
+        uint64_t h = 1469598103934665603ull; // FNV-1a
+        for (char c : text)
+        {
+            h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        return h;
+    }
+
+    std::string_view store(std::string_view text)
+    {
+        if (text.empty()) return std::string_view();
+        if (text.size() > BLOCK_SIZE / 4)
+        {
+            // Uzun isimler kendi bloklarını alır; yazılmakta olan standart blok sonda kalır
+            auto block = std::make_unique<char[]>(text.size());
+            std::copy(text.begin(), text.end(), block.get());
+            std::string_view stored(block.get(), text.size());
+            blocks.insert(blocks.empty() ? blocks.end() : blocks.end() - 1, std::move(block));
+            return stored;
+        }
+        if (text.size() > BLOCK_SIZE - block_used)
+        {
+            blocks.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+            block_used = 0;
+        }
+        char* destination = blocks.back().get() + block_used;
+        std::copy(text.begin(), text.end(), destination);
+        block_used += text.size();
+        return std::string_view(destination, text.size());
+    }
+
+    void grow()
+    {
+        slots.assign(slots.empty() ? 256 : slots.size() * 2, 0);
+        for (SymbolId id = 0; id < names.size(); ++id)
+        {
+            size_t s = hashes[id] & (slots.size() - 1);
+            while (slots[s] != 0) s = (s + 1) & (slots.size() - 1);
+            slots[s] = id + 1;
+        }
+    }
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t block_used = BLOCK_SIZE;  // Son blokta kullanılan byte (başta blok yok)
+    std::vector<std::string_view> names;
+    std::vector<uint64_t> hashes;
+    std::vector<uint32_t> slots;    // id + 1; 0 boş
+};
+
+// Etiket -> adres. İsimler StringInterner'da, adresler SymbolId ile indekslenen dizide
 class SymbolTable
 {
 public:
-    void add_symbol(std::string symbol, int address)
+    SymbolId intern(std::string_view symbol) { return names.intern(symbol); }
+    SymbolId find(std::string_view symbol) const { return names.find(symbol); }
+    std::string_view name(SymbolId id) const { return names.name(id); }
+
+    // Etiketi tanımlar; zaten tanımlıysa dokunmaz ve false döner
+    bool define(SymbolId id, int address)
     {
-        symbols[symbol] = address;
+        if (id >= defined.size())
+        {
+            defined.resize(names.size(), 0);
+            addresses.resize(names.size(), 0);
+        }
+        if (defined[id]) return false;
+        defined[id] = 1;
+        addresses[id] = address;
+        return true;
+    }
+
+    optional<int> value(SymbolId id) const
+    {
+        if (id >= defined.size() || !defined[id]) return nullopt;
+        return addresses[id];
+    }
+
+    void add_symbol(std::string_view symbol, int address)
+    {
+        SymbolId id = intern(symbol);
+        if (!define(id, address)) addresses[id] = address;
     }
 
-    optional<int> get_symbol(std::string symbol)
+    optional<int> get_symbol(std::string_view symbol) const
     {
-        if (symbols.find(symbol) == symbols.end())
+        SymbolId id = find(symbol);
+        return id == INVALID_SYMBOL ? nullopt : value(id);
+    }
+
+    // Tanımlı her etiket için fn(isim, adres) çağırır (tanım sırasıyla değil, numara sırasıyla)
+    template <typename Fn>
+    void for_each_symbol(Fn fn) const
+    {
+        for (SymbolId id = 0; id < defined.size(); ++id)
         {
-            return nullopt;
+            if (defined[id]) fn(names.name(id), addresses[id]);
         }
-        return symbols[symbol];
+    }
+
+    void clear()
+    {
+        names.clear();
+        defined.clear();
+        addresses.clear();
     }
 
 private:
-    std::unordered_map<std::string, int> symbols; // label -> address
+    StringInterner names;
+    std::vector<uint8_t> defined;
+    std::vector<int> addresses;
 };
 
+// Henüz tanımlanmamış etikete yapılan başvuru: etiket tanımlandığında programData'da
+// yamalanacak operand byte'ları
+struct ForwardReference
+{
+    SymbolId symbol;
+    size_t offset;     // programData içindeki ilk operand byte'ı
+    int address;       // Bu byte'ın adresi (LC); göreli uzaklık address + width'ten ölçülür
+    uint8_t width;     // 1 veya 2 byte
+    bool relative;     // true: 8 bit işaretli PC-göreli uzaklık, false: mutlak adres
+    int line;          // Hata mesajları için başvurunun kaynak satırı ve sütunu
+    int column;
+    int section = -1;  // Başvurunun bulunduğu SECTION (-1: mutlak kod)
+    uint32_t next = UINT32_MAX; // Aynı etiketin bir önceki başvurusu (zincir sonu UINT32_MAX)
+    bool pending = true;
+};
+
+// Başvurular tek bir dizide tutulur; her etiket kendi başvurularını next zinciriyle bulur.
+// Etiket tanımlanınca zinciri tek seferde gezilip yamalanır, kaynak ikinci kez okunmaz.
 class ForwardReferenceTable
 {
 public:
-    void add_reference(std::string symbol, int address)
+    void add_reference(ForwardReference reference)
+    {
+        const SymbolId symbol = reference.symbol;
+        if (symbol >= heads.size()) heads.resize(symbol + 1, UINT32_MAX);
+        reference.next = heads[symbol];
+        reference.pending = true;
+        heads[symbol] = static_cast<uint32_t>(entries.size());
+        entries.push_back(reference);
+        pending_count++;
+    }
+
+    // Etiketin bekleyen başvurularının her biri için fn(başvuru) çağırır ve onları kapatır
+    template <typename Fn>
+    void resolve(SymbolId symbol, Fn fn)
     {
-        references[symbol] = address;
+        if (symbol >= heads.size()) return;
+        for (uint32_t i = heads[symbol]; i != UINT32_MAX; i = entries[i].next)
+        {
+            entries[i].pending = false;
+            pending_count--;
+            fn(static_cast<const ForwardReference&>(entries[i]));
+        }
+        heads[symbol] = UINT32_MAX;
     }
 
-    optional<int> get_reference(std::string symbol)
+    // Hâlâ bekleyen başvurular için kaynak sırasıyla fn(başvuru) çağırır
+    template <typename Fn>
+    void for_each_pending(Fn fn) const
     {
-        if (references.find(symbol) == references.end())
+        if (pending_count == 0) return;
+        for (const ForwardReference& reference : entries)
         {
-            return nullopt;
+            if (reference.pending) fn(reference);
         }
-        return references[symbol];
+    }
+
+    size_t pending() const { return pending_count; }
+
+    void clear()
+    {
+        heads.clear();
+        entries.clear();
+        pending_count = 0;
     }
 
 private:
-    std::unordered_map<std::string, int> references; // label -> offset
+    std::vector<uint32_t> heads;          // SymbolId -> son başvuru (yoksa UINT32_MAX)
+    std::vector<ForwardReference> entries;
+    size_t pending_count = 0;
 };
 
 class Instruction
@@ -76,56 +294,153 @@ public:
     int opcode;
     int no_of_bytes;
     AddressingMode addressing_mode;
+    int cycles = 0; // M6800 saat çevrimi sayısı (instructions.txt 5. sütun, yoksa 0)
 };
 
+// Komut arama indeksi: her mnemonic (en fazla 8 karakter) bir uint64_t'ye paketlenir ve
+// açık adresli bir hash tablosunda mnemonic numarasına eşlenir. Her mnemonic için adresleme
+// moduna göre yoğun bir dizi instructions vektöründeki sırayı tutar. Aramalar bellek ayırmaz.
 class InstructionSet
 {
 public:
-    bool is_instruction(std::string instruction)
+    static constexpr size_t MODE_COUNT = static_cast<size_t>(AddressingMode::RELATIVE) + 1;
+
+    bool is_instruction(std::string_view instruction) const
     {
-        for (auto &i : instructions)
-        {
-            if (i.instruction == instruction)
-            {
-                return true;
-            }
-        }
-        return false;
+        return find_mnemonic(instruction) >= 0;
+    }
+
+    // Dosyadaki sırayla mnemonic'in ilk varyantı; yoksa nullptr
+    const Instruction* first_variant(std::string_view instruction) const
+    {
+        int id = find_mnemonic(instruction);
+        return id < 0 ? nullptr : &instructions[mnemonics[id].first];
+    }
+
+    // (mnemonic, mod) çiftinin komutu; yoksa nullptr. Aynı çift birden fazla tanımlıysa ilki.
+    const Instruction* find_instruction(std::string_view instruction, AddressingMode addressing_mode) const
+    {
+        size_t mode = static_cast<size_t>(addressing_mode);
+        int id = find_mnemonic(instruction);
+        if (id < 0 || mode >= MODE_COUNT) return nullptr;
+        int16_t index = mnemonics[id].by_mode[mode];
+        return index < 0 ? nullptr : &instructions[index];
     }
 
-    vector<Instruction> get_instruction(std::string instruction)
+    // Tüm varyantların kopyası (bellek ayırır; sık çağrılan yollarda first_variant/find_instruction kullanın)
+    vector<Instruction> get_instruction(std::string_view instruction) const
     {
         vector<Instruction> inss;
-        for (auto &i : instructions)
+        int id = find_mnemonic(instruction);
+        if (id < 0) return inss;
+        for (const auto &i : instructions)
         {
             if (i.instruction == instruction)
             {
                 inss.push_back(i);
             }
         }
-
         return inss;
     }
 
-    optional<Instruction> get_instruction_wrt_address_mode(std::string instruction, AddressingMode addressing_mode)
+    optional<Instruction> get_instruction_wrt_address_mode(std::string_view instruction, AddressingMode addressing_mode) const
     {
-        for (auto &i : instructions)
-        {
-            if (i.instruction == instruction && i.addressing_mode == addressing_mode)
-            {
-                return i;
-            }
-        }
-        return nullopt;
+        const Instruction* found = find_instruction(instruction, addressing_mode);
+        if (found == nullptr) return nullopt;
+        return *found;
     }
 
     void add_instruction(Instruction instruction)
     {
         instructions.push_back(instruction);
+        index_instruction(instructions.size() - 1);
     }
 
 private:
+    struct MnemonicEntry
+    {
+        int16_t first = -1;                        // İlk varyantın instructions içindeki sırası
+        std::array<int16_t, MODE_COUNT> by_mode;   // Mod -> instructions sırası, yoksa -1
+    };
+
+    struct HashSlot
+    {
+        uint64_t key = 0;  // 0: boş
+        int16_t id = -1;
+    };
+
+    // 1-8 karakterlik mnemonic'i küçük-uçlu olarak paketler; geçersizse 0
+    static uint64_t pack_mnemonic(std::string_view text)
+    {
+        if (text.empty() || text.size() > 8) return 0;
+        uint64_t key = 0;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            key |= static_cast<uint64_t>(static_cast<unsigned char>(text[i])) << (8 * i);
+        }
+        return key;
+    }
+
+    size_t slot_of(uint64_t key) const
+    {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & (slots.size() - 1);
+    }
+
+    int find_mnemonic(std::string_view text) const
+    {
+        uint64_t key = pack_mnemonic(text);
+        if (key == 0 || slots.empty()) return -1;
+        for (size_t s = slot_of(key);; s = (s + 1) & (slots.size() - 1))
+        {
+            if (slots[s].key == key) return slots[s].id;
+            if (slots[s].key == 0) return -1;
+        }
+    }
+
+    void insert_slot(uint64_t key, int16_t id)
+    {
+        size_t s = slot_of(key);
+        while (slots[s].key != 0) s = (s + 1) & (slots.size() - 1);
+        slots[s].key = key;
+        slots[s].id = id;
+    }
+
+    void index_instruction(size_t position)
+    {
+        const Instruction& ins = instructions[position];
+        uint64_t key = pack_mnemonic(ins.instruction);
+        if (key == 0) return; // 8 karakterden uzun mnemonic'ler aranamaz (M6800'de yoktur)
+
+        int id = find_mnemonic(ins.instruction);
+        if (id < 0)
+        {
+            // Doluluk %50'yi geçmesin; büyütürken tüm anahtarlar yeniden yerleştirilir
+            if ((mnemonics.size() + 1) * 2 > slots.size())
+            {
+                std::vector<HashSlot> old = std::move(slots);
+                slots.assign(old.empty() ? 256 : old.size() * 2, HashSlot{});
+                for (const HashSlot& slot : old)
+                {
+                    if (slot.key != 0) insert_slot(slot.key, slot.id);
+                }
+            }
+            id = static_cast<int>(mnemonics.size());
+            MnemonicEntry entry;
+            entry.first = static_cast<int16_t>(position);
+            entry.by_mode.fill(-1);
+            mnemonics.push_back(entry);
+            insert_slot(key, static_cast<int16_t>(id));
+        }
+        size_t mode = static_cast<size_t>(ins.addressing_mode);
+        if (mode < MODE_COUNT && mnemonics[id].by_mode[mode] < 0)
+        {
+            mnemonics[id].by_mode[mode] = static_cast<int16_t>(position);
+        }
+    }
+
     std::vector<Instruction> instructions;
+    std::vector<MnemonicEntry> mnemonics;
+    std::vector<HashSlot> slots;
 };
 
-#endif
\ No newline at end of file
+#endif // MAIN_HPP
\ No newline at end of file
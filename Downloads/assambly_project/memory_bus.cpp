@@ -0,0 +1,185 @@
+#include "memory_bus.hpp"
+#include "emulator.hpp"
+#include <algorithm>
+
+void MemoryDevice::schedule(uint64_t when, uint32_t tag) {
+    if (emulator != nullptr) emulator->schedule_event(when, this, tag);
+}
+
+void MemoryDevice::cancel(uint32_t tag) {
+    if (emulator != nullptr) emulator->cancel_events(this, tag);
+}
+
+void MemoryDevice::set_irq(bool asserted) {
+    if (emulator != nullptr && irq_mask != 0) emulator->set_irq(irq_mask, asserted);
+}
+
+MemoryBus::MemoryBus(uint8_t* backing, Emulator* host) : backing(backing), host(host) {
+    for (size_t page = 0; page < PAGE_COUNT; ++page) {
+        set_page(static_cast<uint8_t>(page), PageKind::RAM);
+    }
+}
+
+void MemoryBus::set_page(uint8_t page, PageKind kind) {
+    uint8_t* base = backing + (static_cast<size_t>(page) << 8);
+    kinds[page] = kind;
+    read_pages[page] = (kind == PageKind::RAM || kind == PageKind::ROM) ? base : nullptr;
+    write_pages[page] = (kind == PageKind::RAM) ? base : nullptr;
+}
+
+void MemoryBus::disconnect(MemoryDevice& device) {
+    if (device.emulator != nullptr) {
+        device.emulator->cancel_events(&device, EventQueue::ANY_TAG);
+        if (device.irq_mask != 0) device.emulator->set_irq(device.irq_mask, false);
+    }
+    device.emulator = nullptr;
+    device.irq_mask = 0;
+}
+
+// address'i kapsayan cihazı bulur; offset cihazın tabanına göre ofsettir
+static const MemoryBus::MappedDevice* find_device(const std::vector<MemoryBus::MappedDevice>& mapped,
+                                                  const std::vector<uint16_t>& candidates, uint16_t address, uint16_t& offset) {
+    for (uint16_t index : candidates) {
+        const MemoryBus::MappedDevice& entry = mapped[index];
+        if (address >= entry.base && address - entry.base < entry.device->size()) {
+            offset = static_cast<uint16_t>(address - entry.base);
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+uint8_t MemoryBus::read_slow(uint16_t address, uint64_t cycles) {
+    const uint8_t page = static_cast<uint8_t>(address >> 8);
+    switch (kinds[page]) {
+        case PageKind::RAM:
+        case PageKind::ROM:
+            return backing[address];
+        case PageKind::DEVICE: {
+            uint16_t offset = 0;
+            if (const MappedDevice* entry = find_device(mapped, page_devices[page], address, offset)) {
+                return entry->device->read(offset, cycles);
+            }
+            return 0xFF;
+        }
+        case PageKind::UNMAPPED:
+            break;
+    }
+    return 0xFF;
+}
+
+void MemoryBus::write_slow(uint16_t address, uint8_t value, uint64_t cycles) {
+    const uint8_t page = static_cast<uint8_t>(address >> 8);
+    switch (kinds[page]) {
+        case PageKind::RAM:
+            backing[address] = value;
+            break;
+        case PageKind::DEVICE: {
+            uint16_t offset = 0;
+            if (const MappedDevice* entry = find_device(mapped, page_devices[page], address, offset)) {
+                entry->device->write(offset, value, cycles);
+            }
+            break;
+        }
+        case PageKind::ROM:
+        case PageKind::UNMAPPED:
+            break; // Yazma yok sayılır
+    }
+}
+
+uint8_t MemoryBus::peek(uint16_t address, uint64_t cycles) const {
+    const uint8_t page = static_cast<uint8_t>(address >> 8);
+    if (kinds[page] == PageKind::RAM || kinds[page] == PageKind::ROM) return backing[address];
+    if (kinds[page] == PageKind::DEVICE) {
+        uint16_t offset = 0;
+        if (const MappedDevice* entry = find_device(mapped, page_devices[page], address, offset)) {
+            return entry->device->peek(offset, cycles);
+        }
+    }
+    return 0xFF;
+}
+
+bool MemoryBus::map(uint16_t start, uint32_t length, PageKind kind) {
+    if (kind == PageKind::DEVICE || length == 0) return false;
+    const uint32_t first_page = start >> 8;
+    const uint32_t last_page = std::min<uint32_t>((static_cast<uint32_t>(start) + length - 1) >> 8, PAGE_COUNT - 1);
+
+    // Aralığa değen cihazlar çıkarılır; sadece onlar yüzünden DEVICE olan diğer sayfalar RAM'e döner
+    auto touches = [&](const MappedDevice& entry) {
+        const uint32_t device_first = entry.base >> 8;
+        const uint32_t device_last = (static_cast<uint32_t>(entry.base) + entry.device->size() - 1) >> 8;
+        return device_first <= last_page && device_last >= first_page;
+    };
+    for (MappedDevice& entry : mapped) {
+        if (touches(entry)) disconnect(*entry.device);
+    }
+    mapped.erase(std::remove_if(mapped.begin(), mapped.end(), touches), mapped.end());
+    for (size_t page = 0; page < PAGE_COUNT; ++page) {
+        page_devices[page].clear();
+    }
+    for (size_t index = 0; index < mapped.size(); ++index) {
+        const MappedDevice& entry = mapped[index];
+        const uint32_t end = static_cast<uint32_t>(entry.base) + entry.device->size();
+        for (uint32_t page = entry.base >> 8; page <= (end - 1) >> 8; ++page) {
+            page_devices[page].push_back(static_cast<uint16_t>(index));
+        }
+    }
+    for (size_t page = 0; page < PAGE_COUNT; ++page) {
+        if (kinds[page] == PageKind::DEVICE && page_devices[page].empty()) set_page(static_cast<uint8_t>(page), PageKind::RAM);
+    }
+
+    for (uint32_t page = first_page; page <= last_page; ++page) {
+        set_page(static_cast<uint8_t>(page), kind);
+    }
+    if (host != nullptr) host->memory_map_changed();
+    return true;
+}
+
+MemoryDevice* MemoryBus::attach(uint16_t base, std::unique_ptr<MemoryDevice> device) {
+    if (!device || device->size() == 0) return nullptr;
+    const uint32_t end = static_cast<uint32_t>(base) + device->size();
+    if (end > PAGE_COUNT * 256) return nullptr;
+    for (const MappedDevice& entry : mapped) {
+        const uint32_t other_end = static_cast<uint32_t>(entry.base) + entry.device->size();
+        if (base < other_end && entry.base < end) return nullptr;
+    }
+
+    uint32_t used_irq = 0;
+    for (const MappedDevice& entry : mapped) used_irq |= entry.device->irq_mask;
+    const uint32_t free_irq = ~used_irq & Emulator::DEVICE_IRQ_SOURCES;
+    device->emulator = host;
+    device->irq_mask = free_irq & (~free_irq + 1); // En düşük boş bit
+
+    const uint16_t index = static_cast<uint16_t>(mapped.size());
+    mapped.push_back(MappedDevice{base, std::move(device)});
+    for (uint32_t page = base >> 8; page <= (end - 1) >> 8; ++page) {
+        page_devices[page].push_back(index);
+        set_page(static_cast<uint8_t>(page), PageKind::DEVICE);
+    }
+    if (host != nullptr) host->memory_map_changed();
+    return mapped.back().device.get();
+}
+
+MemoryDevice* MemoryBus::device_at(uint16_t address) const {
+    uint16_t offset = 0;
+    const MappedDevice* entry = find_device(mapped, page_devices[address >> 8], address, offset);
+    return entry != nullptr ? entry->device.get() : nullptr;
+}
+
+void MemoryBus::reset_devices() {
+    for (MappedDevice& entry : mapped) {
+        entry.device->reset();
+    }
+}
+
+void MemoryBus::clear() {
+    for (MappedDevice& entry : mapped) {
+        disconnect(*entry.device);
+    }
+    mapped.clear();
+    for (size_t page = 0; page < PAGE_COUNT; ++page) {
+        page_devices[page].clear();
+        set_page(static_cast<uint8_t>(page), PageKind::RAM);
+    }
+    if (host != nullptr) host->memory_map_changed();
+}
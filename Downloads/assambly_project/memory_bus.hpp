@@ -0,0 +1,107 @@
+#ifndef MEMORY_BUS_HPP
+#define MEMORY_BUS_HPP
+
+#include "event_queue.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Emulator;
+
+// 256 byte'lık bir sayfanın bus üzerindeki türü (DLL üzerinden int olarak geçer, değerleri değiştirmeyin)
+enum class PageKind : int {
+    RAM = 0,        // Okuma ve yazma doğrudan belleğe (varsayılan)
+    ROM = 1,        // Okuma doğrudan; CPU yazmaları yok sayılır (yükleyici yine yazabilir)
+    DEVICE = 2,     // Her erişim sayfadaki cihazın read/write fonksiyonuna gider
+    UNMAPPED = 3    // Boşluk: okuma $FF (açık bus), yazma yok sayılır
+};
+
+// Belleğe eşlenmiş çevre birimi. Adresler cihazın taban adresine göre ofset olarak gelir;
+// cycles erişimin yapıldığı komutun başındaki CPU çevrimidir. Cihazlar zamanla değişen
+// durumlarını (sayaç vb.) her çevrimde değil, erişildiklerinde bu değerden hesaplar; ileride
+// bir şey olacaksa (kesme gibi) schedule ile olay kuyruğuna zaman damgalı bir olay koyar.
+class MemoryDevice : public EventTarget {
+public:
+    virtual ~MemoryDevice() = default;
+    virtual const char* name() const = 0;
+    virtual uint16_t size() const = 0;   // Kapladığı byte (yazmaç) sayısı
+    virtual uint8_t read(uint16_t offset, uint64_t cycles) = 0;
+    virtual void write(uint16_t offset, uint8_t value, uint64_t cycles) = 0;
+    // Hata ayıklayıcı okuması: okuma yan etkisi olan yazmaçları (ör. alınan veri) değiştirmez
+    virtual uint8_t peek(uint16_t offset, uint64_t cycles) const = 0;
+    virtual void reset() {}
+    void on_event(uint64_t, uint32_t) override {}
+
+protected:
+    // Bus'a takılı değilken hiçbir şey yapmaz
+    void schedule(uint64_t when, uint32_t tag = 0);
+    void cancel(uint32_t tag = EventQueue::ANY_TAG);
+    // IRQ hattı bütün cihazlar arasında "wired-OR"dur; her cihazın kendi kaynak biti vardır
+    void set_irq(bool asserted);
+
+private:
+    friend class MemoryBus;
+    Emulator* emulator = nullptr;
+    uint32_t irq_mask = 0;    // Takılırken boş bir kaynak biti atanır (32'den fazla cihazda 0)
+};
+
+// Emülatörün bellek bus'ı: her 256 byte'lık sayfa için bir okuma ve bir yazma işaretçisi.
+// RAM/ROM sayfalarında işaretçi doğrudan 64KB belleğin ilgili sayfasını gösterir ve erişim
+// bir tablo okuması ile bir dizi erişiminden ibarettir; işaretçi nullptr ise erişim yavaş
+// yola (cihaz, ROM'a yazma, boşluk) gider. Böylece G/Ç cihazı olan programlarda da RAM
+// erişimleri cihaz dağıtımına uğramaz.
+//
+// Cihaz sayfalarının arkasındaki bellek byte'ları CPU tarafından görülmez; hata ayıklayıcı
+// erişimleri (read/write_memory_range) ve yükleyici her zaman doğrudan belleğe gider.
+// Komut getirme de bus'tan geçer; map/attach/clear sayfa türlerini değiştirdiğinde
+// emülatörün çözülmüş blok önbelleği atılır.
+class MemoryBus {
+public:
+    static constexpr size_t PAGE_COUNT = 256;
+
+    // host: cihazların olay ve kesme isteklerini alan emülatör
+    MemoryBus(uint8_t* backing, Emulator* host);
+
+    // Sıcak yol: nullptr ise read_slow / write_slow çağrılmalıdır
+    const uint8_t* read_page(uint8_t page) const { return read_pages[page]; }
+    uint8_t* write_page(uint8_t page) const { return write_pages[page]; }
+    uint8_t read_slow(uint16_t address, uint64_t cycles);
+    void write_slow(uint16_t address, uint8_t value, uint64_t cycles);
+    // Hata ayıklayıcı için yan etkisiz okuma (cihaz sayfalarında peek)
+    uint8_t peek(uint16_t address, uint64_t cycles) const;
+
+    // [start, start + length) aralığına değen bütün sayfaları kind yapar. DEVICE burada
+    // kullanılamaz; o sayfalardaki cihazlar çıkarılır.
+    bool map(uint16_t start, uint32_t length, PageKind kind);
+    PageKind page_kind(uint8_t page) const { return kinds[page]; }
+
+    // Cihazı base adresine takar ve kapladığı sayfaları DEVICE yapar. Aynı sayfada birden
+    // fazla cihaz olabilir; sayfada hiçbir cihaza düşmeyen adresler boşluk gibi davranır.
+    // Başka bir cihazla örtüşürse veya bellek sonunu aşarsa takılmaz ve nullptr döner.
+    MemoryDevice* attach(uint16_t base, std::unique_ptr<MemoryDevice> device);
+    MemoryDevice* device_at(uint16_t address) const;
+    void reset_devices();
+    // Bütün cihazları çıkarır ve bütün sayfaları RAM yapar
+    void clear();
+
+    struct MappedDevice {
+        uint16_t base;
+        std::unique_ptr<MemoryDevice> device;
+    };
+    const std::vector<MappedDevice>& devices() const { return mapped; }
+
+private:
+    void set_page(uint8_t page, PageKind kind);
+    void disconnect(MemoryDevice& device);  // Olaylarını siler, IRQ'sunu bırakır
+
+    uint8_t* backing;
+    Emulator* host;
+    std::array<const uint8_t*, PAGE_COUNT> read_pages{};
+    std::array<uint8_t*, PAGE_COUNT> write_pages{};
+    std::array<PageKind, PAGE_COUNT> kinds{};
+    std::array<std::vector<uint16_t>, PAGE_COUNT> page_devices; // Sayfa -> mapped içindeki indeksler
+    std::vector<MappedDevice> mapped;
+};
+
+#endif // MEMORY_BUS_HPP
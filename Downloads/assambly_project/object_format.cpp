@@ -0,0 +1,369 @@
+#include "object_format.hpp"
+#include "text_format.hpp"
+#include <algorithm>
+#include <cctype>
+#include <ostream>
+
+namespace {
+
+constexpr size_t RECORD_DATA_BYTES = 32;   // S1 / Intel HEX 00 kaydı başına en fazla veri byte'ı
+constexpr size_t ADDRESS_SPACE = 0x10000;
+
+// Kayıtlar ostream formatlaması yerine tek bir string'de biriktirilir ve bir kerede yazılır.
+// Kayıt: "S" tip, sayaç (adres + veri + checksum), adres, veri, birler tümleyeni checksum
+void append_srecord(std::string& out, char type, uint16_t address, const uint8_t* data, size_t length) {
+    uint8_t count = static_cast<uint8_t>(length + 3);
+    uint8_t sum = static_cast<uint8_t>(count + (address >> 8) + (address & 0xFF));
+    out.push_back('S');
+    out.push_back(type);
+    append_hex_byte(out, count);
+    append_hex_byte(out, static_cast<uint8_t>(address >> 8));
+    append_hex_byte(out, static_cast<uint8_t>(address & 0xFF));
+    for (size_t i = 0; i < length; ++i) {
+        append_hex_byte(out, data[i]);
+        sum = static_cast<uint8_t>(sum + data[i]);
+    }
+    append_hex_byte(out, static_cast<uint8_t>(~sum));
+    out.push_back('\n');
+}
+
+// Kayıt: ":" uzunluk, adres, tip, veri, ikiye tümleyen checksum
+void append_hex_record(std::string& out, uint8_t type, uint16_t address, const uint8_t* data, size_t length) {
+    uint8_t sum = static_cast<uint8_t>(length + (address >> 8) + (address & 0xFF) + type);
+    out.push_back(':');
+    append_hex_byte(out, static_cast<uint8_t>(length));
+    append_hex_byte(out, static_cast<uint8_t>(address >> 8));
+    append_hex_byte(out, static_cast<uint8_t>(address & 0xFF));
+    append_hex_byte(out, type);
+    for (size_t i = 0; i < length; ++i) {
+        append_hex_byte(out, data[i]);
+        sum = static_cast<uint8_t>(sum + data[i]);
+    }
+    append_hex_byte(out, static_cast<uint8_t>(-sum));
+    out.push_back('\n');
+}
+
+// Bölümü 64K sınırını ve kayıt boyutunu aşmayan parçalara bölerek record(adres, veri, uzunluk) çağırır
+template <typename RecordFn>
+void for_each_record(const std::vector<uint8_t>& data, const AssemblySegment& segment, RecordFn record) {
+    size_t done = 0;
+    while (done < segment.length) {
+        size_t address = (segment.address + done) % ADDRESS_SPACE;
+        size_t chunk = std::min({RECORD_DATA_BYTES, segment.length - done, ADDRESS_SPACE - address});
+        record(static_cast<uint16_t>(address), data.data() + segment.offset + done, chunk);
+        done += chunk;
+    }
+}
+
+std::string format_s19(const std::vector<uint8_t>& data, const std::vector<AssemblySegment>& segments, uint16_t entry) {
+    static const uint8_t header[] = {'H', 'D', 'R'};
+    std::string out;
+    out.reserve(data.size() * 2 + data.size() / 2 + 64);
+    append_srecord(out, '0', 0x0000, header, sizeof(header));
+    size_t record_count = 0;
+    for (const AssemblySegment& segment : segments) {
+        for_each_record(data, segment, [&](uint16_t address, const uint8_t* bytes, size_t length) {
+            append_srecord(out, '1', address, bytes, length);
+            record_count++;
+        });
+    }
+    if (record_count <= 0xFFFF) {
+        append_srecord(out, '5', static_cast<uint16_t>(record_count), nullptr, 0);
+    }
+    append_srecord(out, '9', entry, nullptr, 0);
+    return out;
+}
+
+std::string format_intel_hex(const std::vector<uint8_t>& data, const std::vector<AssemblySegment>& segments, uint16_t entry) {
+    std::string out;
+    out.reserve(data.size() * 2 + data.size() / 2 + 64);
+    for (const AssemblySegment& segment : segments) {
+        for_each_record(data, segment, [&](uint16_t address, const uint8_t* bytes, size_t length) {
+            append_hex_record(out, 0x00, address, bytes, length);
+        });
+    }
+    const uint8_t start[] = {0x00, 0x00, static_cast<uint8_t>(entry >> 8), static_cast<uint8_t>(entry & 0xFF)};
+    append_hex_record(out, 0x05, 0x0000, start, sizeof(start));
+    append_hex_record(out, 0x01, 0x0000, nullptr, 0);
+    return out;
+}
+
+// Tüm bölümleri kapsayan tek görüntü; bölümler arasındaki boşluklar silinmiş EPROM gibi 0xFF
+std::string format_raw(const std::vector<uint8_t>& data, const std::vector<AssemblySegment>& segments) {
+    size_t low = ADDRESS_SPACE, high = 0;
+    for (const AssemblySegment& segment : segments) {
+        if (segment.length == 0) continue;
+        low = std::min<size_t>(low, segment.address);
+        high = std::max<size_t>(high, std::min(ADDRESS_SPACE, segment.address + segment.length));
+    }
+    if (high <= low) return std::string();
+    std::string out(high - low, static_cast<char>(0xFF));
+    for (const AssemblySegment& segment : segments) {
+        size_t count = std::min(segment.length, ADDRESS_SPACE - segment.address);
+        std::copy_n(data.begin() + segment.offset, count, out.begin() + (segment.address - low));
+    }
+    return out;
+}
+
+std::string format_bit_text(const std::vector<uint8_t>& data) {
+    std::string out;
+    out.reserve(data.size() * 9);
+    for (uint8_t byte_val : data) {
+        for (int bit = 7; bit >= 0; --bit) out.push_back(((byte_val >> bit) & 1) ? '1' : '0');
+        out.push_back('\n');
+    }
+    return out;
+}
+
+// --- Okuma ---
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// Satırdaki hex çiftlerini byte'lara çevirir; tek sayıda veya geçersiz karakterde false
+bool decode_hex_pairs(const char* text, size_t length, std::vector<uint8_t>& out) {
+    if (length % 2 != 0) return false;
+    out.clear();
+    for (size_t i = 0; i < length; i += 2) {
+        int high = hex_value(text[i]), low = hex_value(text[i + 1]);
+        if (high < 0 || low < 0) return false;
+        out.push_back(static_cast<uint8_t>((high << 4) | low));
+    }
+    return true;
+}
+
+// Kayıt byte'larını görüntüye ekler; önceki bölümün hemen devamıysa onu uzatır
+bool append_to_image(ObjectImage& image, size_t address, const uint8_t* bytes, size_t length) {
+    if (length == 0) return true;
+    if (address + length > ADDRESS_SPACE) return false;
+    if (image.segments.empty() ||
+        image.segments.back().address + image.segments.back().length != address) {
+        image.segments.push_back(AssemblySegment{static_cast<uint16_t>(address), image.data.size(), 0});
+    }
+    image.data.insert(image.data.end(), bytes, bytes + length);
+    image.segments.back().length += length;
+    return true;
+}
+
+// Satırları sırayla line_fn(satır_no, başlangıç, uzunluk) ile işler; boş satırlar atlanır
+template <typename LineFn>
+bool for_each_line(const uint8_t* bytes, size_t length, LineFn line_fn) {
+    const char* text = reinterpret_cast<const char*>(bytes);
+    size_t pos = 0;
+    int line_number = 0;
+    while (pos < length) {
+        size_t end = pos;
+        while (end < length && text[end] != '\n') ++end;
+        line_number++;
+        size_t start = pos, stop = end;
+        while (start < stop && std::isspace(static_cast<unsigned char>(text[start]))) ++start;
+        while (stop > start && std::isspace(static_cast<unsigned char>(text[stop - 1]))) --stop;
+        if (stop > start && !line_fn(line_number, text + start, stop - start)) return false;
+        pos = end + 1;
+    }
+    return true;
+}
+
+bool read_s19(const uint8_t* bytes, size_t length, ObjectImage& image, std::string& error) {
+    std::vector<uint8_t> record;
+    return for_each_line(bytes, length, [&](int line, const char* text, size_t size) {
+        const std::string where = "S19 satir " + std::to_string(line) + ": ";
+        if (size < 4 || text[0] != 'S' || !decode_hex_pairs(text + 2, size - 2, record) || record.empty()) {
+            error = where + "gecersiz kayit";
+            return false;
+        }
+        if (record[0] + 1u != record.size()) {
+            error = where + "sayac kayit uzunluguyla uyusmuyor";
+            return false;
+        }
+        uint8_t sum = 0;
+        for (size_t i = 0; i + 1 < record.size(); ++i) sum = static_cast<uint8_t>(sum + record[i]);
+        if (static_cast<uint8_t>(~sum) != record.back()) {
+            error = where + "checksum hatasi";
+            return false;
+        }
+        size_t address_bytes;
+        switch (text[1]) {
+            case '0': case '1': case '5': case '9': address_bytes = 2; break;
+            case '2': case '6': case '8': address_bytes = 3; break;
+            case '3': case '7': address_bytes = 4; break;
+            default:
+                error = where + "bilinmeyen kayit tipi S" + text[1];
+                return false;
+        }
+        if (record.size() < address_bytes + 2) {
+            error = where + "kayit cok kisa";
+            return false;
+        }
+        size_t address = 0;
+        for (size_t i = 0; i < address_bytes; ++i) address = (address << 8) | record[1 + i];
+        const uint8_t* payload = record.data() + 1 + address_bytes;
+        size_t payload_length = record.size() - address_bytes - 2;
+
+        switch (text[1]) {
+            case '1': case '2': case '3':
+                if (!append_to_image(image, address, payload, payload_length)) {
+                    error = where + "veri 64KB adres alaninin disinda";
+                    return false;
+                }
+                break;
+            case '7': case '8': case '9':
+                if (address >= ADDRESS_SPACE) {
+                    error = where + "baslangic adresi 64KB disinda";
+                    return false;
+                }
+                image.entry = static_cast<uint16_t>(address);
+                image.has_entry = true;
+                break;
+            default: // S0 başlık, S5/S6 kayıt sayısı: sadece doğrulanır
+                break;
+        }
+        return true;
+    });
+}
+
+bool read_intel_hex(const uint8_t* bytes, size_t length, ObjectImage& image, std::string& error) {
+    std::vector<uint8_t> record;
+    size_t upper_address = 0; // 02/04 kayıtlarından gelen üst adres; 6800 için sıfır olmalı
+    bool finished = false;
+    bool ok = for_each_line(bytes, length, [&](int line, const char* text, size_t size) {
+        const std::string where = "Intel HEX satir " + std::to_string(line) + ": ";
+        if (finished) return true; // 01 kaydından sonrası yok sayılır
+        if (size < 11 || text[0] != ':' || !decode_hex_pairs(text + 1, size - 1, record)) {
+            error = where + "gecersiz kayit";
+            return false;
+        }
+        if (record[0] + 5u != record.size()) {
+            error = where + "uzunluk kayitla uyusmuyor";
+            return false;
+        }
+        uint8_t sum = 0;
+        for (uint8_t b : record) sum = static_cast<uint8_t>(sum + b);
+        if (sum != 0) {
+            error = where + "checksum hatasi";
+            return false;
+        }
+        size_t address = (static_cast<size_t>(record[1]) << 8) | record[2];
+        const uint8_t* payload = record.data() + 4;
+        size_t payload_length = record[0];
+
+        switch (record[3]) {
+            case 0x00:
+                if (!append_to_image(image, upper_address + address, payload, payload_length)) {
+                    error = where + "veri 64KB adres alaninin disinda";
+                    return false;
+                }
+                break;
+            case 0x01:
+                finished = true;
+                break;
+            case 0x02: case 0x04:
+                if (payload_length != 2) {
+                    error = where + "gecersiz genisletilmis adres kaydi";
+                    return false;
+                }
+                upper_address = (static_cast<size_t>(payload[0]) << 8 | payload[1]) << (record[3] == 0x02 ? 4 : 16);
+                break;
+            case 0x03: case 0x05: {
+                if (payload_length != 4) {
+                    error = where + "gecersiz baslangic adresi kaydi";
+                    return false;
+                }
+                // 03: CS:IP, 05: doğrusal adres
+                size_t high = (static_cast<size_t>(payload[0]) << 8) | payload[1];
+                size_t low = (static_cast<size_t>(payload[2]) << 8) | payload[3];
+                size_t start = (record[3] == 0x03) ? (high << 4) + low : (high << 16) | low;
+                if (start >= ADDRESS_SPACE) {
+                    error = where + "baslangic adresi 64KB disinda";
+                    return false;
+                }
+                image.entry = static_cast<uint16_t>(start);
+                image.has_entry = true;
+                break;
+            }
+            default:
+                error = where + "bilinmeyen kayit tipi";
+                return false;
+        }
+        return true;
+    });
+    if (ok && !finished) {
+        error = "Intel HEX: bitis (01) kaydi yok";
+        return false;
+    }
+    return ok;
+}
+
+} // namespace
+
+ObjectFormat object_format_from_name(const std::string& name) {
+    std::string lower = name;
+    for (char& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (lower == "raw" || lower == "bin") return ObjectFormat::RAW;
+    if (lower == "s19" || lower == "srec") return ObjectFormat::S19;
+    if (lower == "hex" || lower == "ihex") return ObjectFormat::INTEL_HEX;
+    if (lower == "bits" || lower == "txt") return ObjectFormat::BIT_TEXT;
+    if (lower == "rel") return ObjectFormat::RELOCATABLE;
+    return ObjectFormat::AUTO;
+}
+
+ObjectFormat object_format_from_extension(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || path.find_first_of("/\\", dot) != std::string::npos) return ObjectFormat::BIT_TEXT;
+    std::string ext = path.substr(dot + 1);
+    for (char& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (ext == "bin") return ObjectFormat::RAW;
+    if (ext == "s19" || ext == "srec" || ext == "mot") return ObjectFormat::S19;
+    if (ext == "hex" || ext == "ihx") return ObjectFormat::INTEL_HEX;
+    if (ext == "rel") return ObjectFormat::RELOCATABLE;
+    return ObjectFormat::BIT_TEXT;
+}
+
+bool write_object(std::ostream& out, ObjectFormat format, const std::vector<uint8_t>& data,
+                  const std::vector<AssemblySegment>& segments, uint16_t entry) {
+    std::string text;
+    switch (format) {
+        case ObjectFormat::RAW: text = format_raw(data, segments); break;
+        case ObjectFormat::S19: text = format_s19(data, segments, entry); break;
+        case ObjectFormat::INTEL_HEX: text = format_intel_hex(data, segments, entry); break;
+        case ObjectFormat::BIT_TEXT: text = format_bit_text(data); break;
+        case ObjectFormat::AUTO:
+        case ObjectFormat::RELOCATABLE: return false;
+    }
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(out);
+}
+
+bool read_object(const uint8_t* bytes, size_t length, ObjectFormat format, uint16_t raw_base,
+                 ObjectImage& image, std::string& error) {
+    image = ObjectImage();
+    if (bytes == nullptr) length = 0;
+    if (format == ObjectFormat::AUTO) {
+        size_t first = 0;
+        while (first < length && std::isspace(bytes[first])) ++first;
+        if (first < length && bytes[first] == 'S') format = ObjectFormat::S19;
+        else if (first < length && bytes[first] == ':') format = ObjectFormat::INTEL_HEX;
+        else format = ObjectFormat::RAW;
+    }
+    switch (format) {
+        case ObjectFormat::S19: return read_s19(bytes, length, image, error);
+        case ObjectFormat::INTEL_HEX: return read_intel_hex(bytes, length, image, error);
+        case ObjectFormat::RAW:
+            if (raw_base + length > ADDRESS_SPACE) {
+                std::string base_text;
+                append_hex_byte(base_text, static_cast<uint8_t>(raw_base >> 8));
+                append_hex_byte(base_text, static_cast<uint8_t>(raw_base & 0xFF));
+                error = "Ham goruntu $" + base_text + " adresinden itibaren 64KB'a sigmiyor";
+                return false;
+            }
+            append_to_image(image, raw_base, bytes, length);
+            return true;
+        default:
+            error = "Bu bicim okunamaz (sadece raw, S19 ve Intel HEX)";
+            return false;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef OBJECT_FORMAT_HPP
+#define OBJECT_FORMAT_HPP
+
+#include "assembler.hpp" // AssemblySegment
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Nesne dosyası biçimleri. Sayısal değerler load_object_dll'in format parametresiyle aynıdır.
+enum class ObjectFormat : int {
+    AUTO = 0,        // Sadece okurken: 'S' ile başlıyorsa S19, ':' ile başlıyorsa Intel HEX, yoksa ham
+    RAW = 1,         // Ham byte'lar; en düşük bölüm adresinden en yükseğe kadar, boşluklar 0xFF
+    S19 = 2,         // Motorola S-record (S0/S1/S5/S9)
+    INTEL_HEX = 3,   // Intel HEX (00/05/01 kayıtları)
+    BIT_TEXT = 4,    // Eski object.txt biçimi: her satırda bir byte, "01011010"
+    RELOCATABLE = 5  // Yeniden konumlandırılabilir modül (.rel); write_module ile yazılır, linker ile bağlanır
+};
+
+// Bellek görüntüsü: AssemblyContext ile aynı düzende byte'lar ve bölümleri
+struct ObjectImage {
+    std::vector<uint8_t> data;
+    std::vector<AssemblySegment> segments;
+    uint16_t entry = 0;      // Başlangıç adresi (S9 / Intel HEX 05 kaydı)
+    bool has_entry = false;
+};
+
+// "raw"/"bin", "s19"/"srec", "hex"/"ihex", "bits", "rel"; tanınmazsa AUTO döner
+ObjectFormat object_format_from_name(const std::string& name);
+// Dosya uzantısına göre biçim (.bin, .s19/.srec/.mot, .hex/.ihx, .rel); diğerleri BIT_TEXT
+ObjectFormat object_format_from_extension(const std::string& path);
+
+// Bölümleri kendi adresleriyle yazar. entry sadece S19 ve Intel HEX'te saklanır.
+// RELOCATABLE burada yazılamaz (false döner); object_module.hpp'deki write_module kullanılır.
+bool write_object(std::ostream& out, ObjectFormat format, const std::vector<uint8_t>& data,
+                  const std::vector<AssemblySegment>& segments, uint16_t entry);
+
+// bytes içeriğini ayrıştırıp image'a bölümler halinde koyar. Ham biçimde tüm içerik
+// raw_base adresinden başlayan tek bölümdür. Hatalı kayıt veya checksum'da false döner.
+bool read_object(const uint8_t* bytes, size_t length, ObjectFormat format, uint16_t raw_base,
+                 ObjectImage& image, std::string& error);
+
+#endif // OBJECT_FORMAT_HPP
@@ -0,0 +1,404 @@
+#include "object_module.hpp"
+#include "text_format.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+constexpr size_t ADDRESS_SPACE = 0x10000;
+constexpr size_t DATA_RECORD_BYTES = 32;   // DATA satırı başına en fazla byte
+void append_hex_word(std::string& out, uint16_t value) {
+    append_hex_byte(out, static_cast<uint8_t>(value >> 8));
+    append_hex_byte(out, static_cast<uint8_t>(value & 0xFF));
+}
+
+std::string hex_word(uint32_t value) {
+    std::string out;
+    append_hex_word(out, static_cast<uint16_t>(value));
+    return out;
+}
+
+const char* relocation_kind_name(RelocationKind kind) {
+    return kind == RelocationKind::RELATIVE8 ? "REL8" : "ABS16";
+}
+
+size_t relocation_width(RelocationKind kind) {
+    return kind == RelocationKind::RELATIVE8 ? 1 : 2;
+}
+
+// --- Okuma yardımcıları ---
+
+bool parse_hex(const std::string& text, uint32_t limit, uint32_t& out) {
+    if (text.empty() || text.size() > 8) return false;
+    uint32_t value = 0;
+    for (char c : text) {
+        if (!std::isxdigit(static_cast<unsigned char>(c))) return false;
+        value = value * 16 + static_cast<uint32_t>(c <= '9' ? c - '0' : std::toupper(static_cast<unsigned char>(c)) - 'A' + 10);
+    }
+    if (value > limit) return false;
+    out = value;
+    return true;
+}
+
+bool parse_index(const std::string& text, size_t count, uint32_t& out) {
+    if (text.empty() || text.size() > 9 || !std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return false;
+    }
+    out = static_cast<uint32_t>(std::strtoul(text.c_str(), nullptr, 10));
+    return out < count;
+}
+
+bool parse_kind(const std::string& text, RelocationKind& kind) {
+    if (text == "ABS16") kind = RelocationKind::ABSOLUTE16;
+    else if (text == "REL8") kind = RelocationKind::RELATIVE8;
+    else return false;
+    return true;
+}
+
+} // namespace
+
+void build_module(const AssemblyContext& ctx, const std::string& name, ObjectModule& module) {
+    module = ObjectModule();
+    module.name = name;
+    module.entry = static_cast<uint16_t>(ctx.origin);
+    module.has_entry = ctx.has_origin;
+
+    // SECTION'lar ctx.sections ile aynı indekslerde; boşluklar silinmiş EPROM gibi 0xFF
+    for (size_t i = 0; i < ctx.sections.size(); ++i) {
+        ModuleSection section;
+        section.name = ctx.sections[i];
+        int size = (static_cast<int>(i) == ctx.section) ? ctx.LC : ctx.section_lc[i];
+        section.data.assign(static_cast<size_t>(std::max(size, 0)), 0xFF);
+        module.sections.push_back(std::move(section));
+    }
+    // ORG ile yazılmış her parça ayrı bir mutlak bölüm olur
+    std::vector<uint32_t> segment_sections(ctx.segments.size());
+    for (size_t i = 0; i < ctx.segments.size(); ++i) {
+        const AssemblySegment& segment = ctx.segments[i];
+        auto first = ctx.programData.begin() + segment.offset;
+        if (segment.section >= 0) {
+            std::vector<uint8_t>& data = module.sections[segment.section].data;
+            if (data.size() < segment.address + segment.length) data.resize(segment.address + segment.length, 0xFF);
+            std::copy(first, first + segment.length, data.begin() + segment.address);
+            segment_sections[i] = static_cast<uint32_t>(segment.section);
+        } else {
+            ModuleSection section;
+            section.absolute = true;
+            section.address = segment.address;
+            section.data.assign(first, first + segment.length);
+            segment_sections[i] = static_cast<uint32_t>(module.sections.size());
+            module.sections.push_back(std::move(section));
+        }
+    }
+
+    for (const AssemblyRelocation& relocation : ctx.relocations) {
+        // programData ofsetini içeren parça (parçalar ofset sırasıyla tutulur)
+        auto after = std::upper_bound(ctx.segments.begin(), ctx.segments.end(), relocation.offset,
+                                      [](size_t offset, const AssemblySegment& segment) { return offset < segment.offset; });
+        if (after == ctx.segments.begin()) continue;
+        const AssemblySegment& segment = *(after - 1);
+        ModuleRelocation entry;
+        entry.section = segment_sections[after - 1 - ctx.segments.begin()];
+        entry.offset = static_cast<uint16_t>((segment.section >= 0 ? segment.address : 0) + (relocation.offset - segment.offset));
+        entry.kind = relocation.kind;
+        entry.symbol = std::string(ctx.symbolTable.name(relocation.symbol));
+        if (ctx.flags(relocation.symbol) & SYMBOL_IMPORTED) {
+            entry.target = RelocationTarget::IMPORT;
+        } else {
+            int target_section = ctx.symbol_section(relocation.symbol);
+            entry.target = target_section >= 0 ? RelocationTarget::SECTION : RelocationTarget::ABSOLUTE;
+            entry.target_section = static_cast<uint32_t>(std::max(target_section, 0));
+            entry.value = static_cast<uint16_t>(ctx.symbolTable.value(relocation.symbol).value_or(0));
+        }
+        module.relocations.push_back(std::move(entry));
+    }
+
+    for (const SymbolDeclaration& declaration : ctx.exports) {
+        auto value = ctx.symbolTable.value(declaration.symbol);
+        if (!value.has_value()) continue; // finish_assembly hata olarak bildirir
+        module.exports.push_back(ModuleSymbol{std::string(ctx.symbolTable.name(declaration.symbol)),
+                                              ctx.symbol_section(declaration.symbol), static_cast<uint16_t>(value.value())});
+    }
+    for (const SymbolDeclaration& declaration : ctx.imports) {
+        module.imports.emplace_back(ctx.symbolTable.name(declaration.symbol));
+    }
+}
+
+// M6800OBJ 1
+// MODULE ad
+// SECTION ad boyut | ABSOLUTE adres boyut       (bölümler sırayla 0, 1, ... numaralanır)
+// DATA bölüm ofset byte'lar
+// EXPORT ad bölüm|- değer
+// IMPORT ad
+// RELOC bölüm ofset ABS16|REL8 SECTION hedef_bölüm değer ad | ABSOLUTE değer ad | IMPORT ad
+// ENTRY adres
+// END
+// Sayılar 4 basamak hex, bölüm numaraları ondalıktır.
+bool write_module(std::ostream& out, const ObjectModule& module) {
+    std::string text = "M6800OBJ 1\nMODULE " + module.name + "\n";
+    for (const ModuleSection& section : module.sections) {
+        if (section.absolute) text += "ABSOLUTE " + hex_word(section.address) + " " + hex_word(static_cast<uint32_t>(section.data.size())) + "\n";
+        else text += "SECTION " + section.name + " " + hex_word(static_cast<uint32_t>(section.data.size())) + "\n";
+    }
+    for (size_t index = 0; index < module.sections.size(); ++index) {
+        const std::vector<uint8_t>& data = module.sections[index].data;
+        for (size_t done = 0; done < data.size(); done += DATA_RECORD_BYTES) {
+            text += "DATA " + std::to_string(index) + " " + hex_word(static_cast<uint32_t>(done)) + " ";
+            for (size_t i = done; i < std::min(data.size(), done + DATA_RECORD_BYTES); ++i) append_hex_byte(text, data[i]);
+            text.push_back('\n');
+        }
+    }
+    for (const ModuleSymbol& symbol : module.exports) {
+        text += "EXPORT " + symbol.name + " " + (symbol.section >= 0 ? std::to_string(symbol.section) : "-")
+              + " " + hex_word(symbol.value) + "\n";
+    }
+    for (const std::string& name : module.imports) text += "IMPORT " + name + "\n";
+    for (const ModuleRelocation& relocation : module.relocations) {
+        text += "RELOC " + std::to_string(relocation.section) + " " + hex_word(relocation.offset) + " "
+              + relocation_kind_name(relocation.kind) + " ";
+        switch (relocation.target) {
+            case RelocationTarget::SECTION:
+                text += "SECTION " + std::to_string(relocation.target_section) + " " + hex_word(relocation.value) + " ";
+                break;
+            case RelocationTarget::ABSOLUTE: text += "ABSOLUTE " + hex_word(relocation.value) + " "; break;
+            case RelocationTarget::IMPORT: text += "IMPORT "; break;
+        }
+        text += relocation.symbol + "\n";
+    }
+    if (module.has_entry) text += "ENTRY " + hex_word(module.entry) + "\n";
+    text += "END\n";
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(out);
+}
+
+bool read_module(const char* text, size_t length, ObjectModule& module, std::string& error) {
+    module = ObjectModule();
+    std::istringstream in(std::string(text != nullptr ? text : "", text != nullptr ? length : 0));
+    std::string line;
+    int line_number = 0;
+    bool header = false, ended = false;
+    auto fail = [&](const std::string& message) {
+        error = "Satir " + std::to_string(line_number) + ": " + message;
+        return false;
+    };
+    while (std::getline(in, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::istringstream fields(line);
+        std::vector<std::string> words;
+        for (std::string word; fields >> word;) words.push_back(word);
+        if (words.empty()) continue;
+        if (ended) return fail("END'den sonra kayit");
+        const std::string& record = words[0];
+        if (!header) {
+            if (words.size() != 2 || record != "M6800OBJ" || words[1] != "1") return fail("M6800OBJ 1 basligi bekleniyordu");
+            header = true;
+            continue;
+        }
+        uint32_t a = 0, b = 0, c = 0;
+        if (record == "MODULE" && words.size() == 2) {
+            module.name = words[1];
+        } else if (record == "SECTION" && words.size() == 3 && parse_hex(words[2], 0xFFFF, a)) {
+            ModuleSection section;
+            section.name = words[1];
+            section.data.assign(a, 0xFF);
+            module.sections.push_back(std::move(section));
+        } else if (record == "ABSOLUTE" && words.size() == 3 && parse_hex(words[1], 0xFFFF, a) && parse_hex(words[2], 0x10000, b)) {
+            ModuleSection section;
+            section.absolute = true;
+            section.address = static_cast<uint16_t>(a);
+            section.data.assign(b, 0xFF);
+            module.sections.push_back(std::move(section));
+        } else if (record == "DATA" && words.size() == 4 && parse_index(words[1], module.sections.size(), a)
+                   && parse_hex(words[2], 0xFFFF, b) && words[3].size() % 2 == 0) {
+            std::vector<uint8_t>& data = module.sections[a].data;
+            if (b + words[3].size() / 2 > data.size()) return fail("DATA bolum boyutunu asiyor");
+            for (size_t i = 0; i < words[3].size(); i += 2) {
+                if (!parse_hex(words[3].substr(i, 2), 0xFF, c)) return fail("Gecersiz DATA byte'i");
+                data[b + i / 2] = static_cast<uint8_t>(c);
+            }
+        } else if (record == "EXPORT" && words.size() == 4 && parse_hex(words[3], 0xFFFF, b)
+                   && (words[2] == "-" || parse_index(words[2], module.sections.size(), a))) {
+            module.exports.push_back(ModuleSymbol{words[1], words[2] == "-" ? -1 : static_cast<int>(a), static_cast<uint16_t>(b)});
+        } else if (record == "IMPORT" && words.size() == 2) {
+            module.imports.push_back(words[1]);
+        } else if (record == "RELOC" && words.size() >= 6 && parse_index(words[1], module.sections.size(), a)
+                   && parse_hex(words[2], 0xFFFF, b)) {
+            ModuleRelocation relocation;
+            relocation.section = a;
+            relocation.offset = static_cast<uint16_t>(b);
+            relocation.symbol = words.back();
+            bool ok = parse_kind(words[3], relocation.kind);
+            if (words[4] == "SECTION" && words.size() == 8) {
+                relocation.target = RelocationTarget::SECTION;
+                ok = ok && parse_index(words[5], module.sections.size(), relocation.target_section) && parse_hex(words[6], 0xFFFF, c);
+                relocation.value = static_cast<uint16_t>(c);
+            } else if (words[4] == "ABSOLUTE" && words.size() == 7) {
+                relocation.target = RelocationTarget::ABSOLUTE;
+                ok = ok && parse_hex(words[5], 0xFFFF, c);
+                relocation.value = static_cast<uint16_t>(c);
+            } else if (words[4] == "IMPORT" && words.size() == 6) {
+                relocation.target = RelocationTarget::IMPORT;
+            } else {
+                ok = false;
+            }
+            if (!ok) return fail("Gecersiz RELOC kaydi");
+            if (relocation.offset + relocation_width(relocation.kind) > module.sections[a].data.size()) {
+                return fail("RELOC bolum disini gosteriyor");
+            }
+            module.relocations.push_back(std::move(relocation));
+        } else if (record == "ENTRY" && words.size() == 2 && parse_hex(words[1], 0xFFFF, a)) {
+            module.entry = static_cast<uint16_t>(a);
+            module.has_entry = true;
+        } else if (record == "END" && words.size() == 1) {
+            ended = true;
+        } else {
+            return fail("Gecersiz kayit '" + line + "'");
+        }
+    }
+    if (!header) return fail("M6800OBJ 1 basligi yok");
+    if (!ended) return fail("END kaydi yok");
+    return true;
+}
+
+bool link_modules(const std::vector<ObjectModule>& modules, const LinkOptions& options,
+                  ObjectImage& image, std::vector<std::string>& errors) {
+    image = ObjectImage();
+    const size_t first_error = errors.size();
+
+    // 1. Yerleşim: bases[modül][bölüm] = son adres
+    std::vector<std::vector<uint32_t>> bases(modules.size());
+    std::vector<std::string> names;
+    for (size_t m = 0; m < modules.size(); ++m) {
+        bases[m].assign(modules[m].sections.size(), 0);
+        for (size_t s = 0; s < modules[m].sections.size(); ++s) {
+            const ModuleSection& section = modules[m].sections[s];
+            if (section.absolute) bases[m][s] = section.address;
+            else if (std::find(names.begin(), names.end(), section.name) == names.end()) names.push_back(section.name);
+        }
+    }
+    for (const auto& base : options.section_bases) {
+        if (std::find(names.begin(), names.end(), base.first) == names.end()) {
+            errors.push_back("--base: '" + base.first + "' adli bolum hicbir modulde yok");
+        }
+    }
+    uint32_t cursor = options.default_base;
+    for (const std::string& name : names) {
+        for (const auto& base : options.section_bases) {
+            if (base.first == name) cursor = base.second;
+        }
+        for (size_t m = 0; m < modules.size(); ++m) {
+            for (size_t s = 0; s < modules[m].sections.size(); ++s) {
+                const ModuleSection& section = modules[m].sections[s];
+                if (section.absolute || section.name != name) continue;
+                bases[m][s] = cursor;
+                cursor += static_cast<uint32_t>(section.data.size());
+                if (cursor > ADDRESS_SPACE) {
+                    errors.push_back("Bolum '" + name + "' (modul " + modules[m].name + ") 64KB adres alanini asiyor");
+                }
+            }
+        }
+    }
+
+    // 2. Dışa açılan semboller
+    struct GlobalSymbol { uint16_t address; size_t module; };
+    std::unordered_map<std::string, GlobalSymbol> globals;
+    for (size_t m = 0; m < modules.size(); ++m) {
+        for (const ModuleSymbol& symbol : modules[m].exports) {
+            if (symbol.section >= static_cast<int>(modules[m].sections.size())) {
+                errors.push_back("Sembol '" + symbol.name + "' (modul " + modules[m].name + ") gecersiz bolumde");
+                continue;
+            }
+            uint32_t address = symbol.section >= 0 ? bases[m][symbol.section] + symbol.value : symbol.value;
+            auto inserted = globals.emplace(symbol.name, GlobalSymbol{static_cast<uint16_t>(address), m});
+            if (!inserted.second) {
+                errors.push_back("Sembol '" + symbol.name + "' iki kez XDEF edilmis (modul "
+                                 + modules[inserted.first->second.module].name + " ve " + modules[m].name + ")");
+            }
+        }
+    }
+
+    // 3. Görüntü: her bölüm kendi adresinde bir parça
+    std::vector<std::vector<size_t>> offsets(modules.size());
+    for (size_t m = 0; m < modules.size(); ++m) {
+        offsets[m].assign(modules[m].sections.size(), 0);
+        for (size_t s = 0; s < modules[m].sections.size(); ++s) {
+            const std::vector<uint8_t>& data = modules[m].sections[s].data;
+            offsets[m][s] = image.data.size();
+            if (data.empty()) continue;
+            image.data.insert(image.data.end(), data.begin(), data.end());
+            image.segments.push_back(AssemblySegment{static_cast<uint16_t>(bases[m][s]), offsets[m][s], data.size()});
+        }
+    }
+
+    // 4. Yeniden konumlandırmalar
+    for (size_t m = 0; m < modules.size(); ++m) {
+        const ObjectModule& module = modules[m];
+        for (const ModuleRelocation& relocation : module.relocations) {
+            if (relocation.section >= module.sections.size()
+                || relocation.offset + relocation_width(relocation.kind) > module.sections[relocation.section].data.size()
+                || (relocation.target == RelocationTarget::SECTION && relocation.target_section >= module.sections.size())) {
+                errors.push_back("Gecersiz yeniden konumlandirma kaydi (modul " + module.name + ", '" + relocation.symbol + "')");
+                continue;
+            }
+            uint32_t target = relocation.value;
+            if (relocation.target == RelocationTarget::SECTION) {
+                target = bases[m][relocation.target_section] + relocation.value;
+            } else if (relocation.target == RelocationTarget::IMPORT) {
+                auto found = globals.find(relocation.symbol);
+                if (found == globals.end()) {
+                    errors.push_back("Tanimsiz sembol '" + relocation.symbol + "' (modul " + module.name + ")");
+                    continue;
+                }
+                target = found->second.address;
+            }
+            uint8_t* bytes = image.data.data() + offsets[m][relocation.section] + relocation.offset;
+            uint32_t address = bases[m][relocation.section] + relocation.offset;
+            if (relocation.kind == RelocationKind::ABSOLUTE16) {
+                bytes[0] = static_cast<uint8_t>((target >> 8) & 0xFF);
+                bytes[1] = static_cast<uint8_t>(target & 0xFF);
+            } else {
+                int distance = static_cast<int>(target) - static_cast<int>(address + 1);
+                if (distance < -128 || distance > 127) {
+                    errors.push_back("Dallanma hedefi '" + relocation.symbol + "' menzil disinda (" + std::to_string(distance)
+                                     + " byte, modul " + module.name + ", $" + hex_word(address - 1) + ")");
+                    continue;
+                }
+                bytes[0] = static_cast<uint8_t>(distance & 0xFF);
+            }
+        }
+    }
+
+    // 5. Çakışan bölümler
+    std::vector<AssemblySegment> sorted = image.segments;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const AssemblySegment& a, const AssemblySegment& b) { return a.address < b.address; });
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        if (sorted[i].address < sorted[i - 1].address + sorted[i - 1].length) {
+            errors.push_back("Bolumler cakisiyor: $" + hex_word(sorted[i - 1].address) + "-$"
+                             + hex_word(sorted[i - 1].address + sorted[i - 1].length - 1) + " ve $" + hex_word(sorted[i].address));
+        }
+    }
+    image.segments = std::move(sorted); // Çıktı dosyaları adres sırasıyla yazılır
+
+    // 6. Başlangıç adresi
+    if (!options.entry_symbol.empty()) {
+        auto found = globals.find(options.entry_symbol);
+        if (found == globals.end()) errors.push_back("Baslangic sembolu '" + options.entry_symbol + "' XDEF edilmemis");
+        else { image.entry = found->second.address; image.has_entry = true; }
+    } else {
+        for (const ObjectModule& module : modules) {
+            if (module.has_entry) { image.entry = module.entry; image.has_entry = true; break; }
+        }
+        for (size_t m = 0; m < modules.size() && !image.has_entry; ++m) {
+            for (size_t s = 0; s < modules[m].sections.size() && !image.has_entry; ++s) {
+                if (!modules[m].sections[s].data.empty()) { image.entry = static_cast<uint16_t>(bases[m][s]); image.has_entry = true; }
+            }
+        }
+    }
+    return errors.size() == first_error;
+}
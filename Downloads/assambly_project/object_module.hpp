@@ -0,0 +1,77 @@
+#ifndef OBJECT_MODULE_HPP
+#define OBJECT_MODULE_HPP
+
+#include "assembler.hpp"     // AssemblyContext, RelocationKind
+#include "object_format.hpp" // ObjectImage
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Yeniden konumlandırılabilir nesne modülü (.rel). SECTION bölümleri 0'dan başlayan
+// adreslerle, ORG ile yazılmış kod ise mutlak bölümler olarak saklanır; bölümlerin son
+// adresleri bağlama (link_modules) sırasında belirlenir. Modüller birbirinden bağımsız
+// derlendiği için ayrı iş parçacıklarında üretilebilir ve değişmeyenler yeniden derlenmez.
+struct ModuleSection {
+    std::string name;            // Mutlak bölümlerde boş
+    bool absolute = false;
+    uint16_t address = 0;        // Mutlak bölümün yükleme adresi
+    std::vector<uint8_t> data;
+};
+
+// Yeniden konumlandırma hedefi
+enum class RelocationTarget : uint8_t {
+    SECTION,   // Bu modülün bir bölümündeki etiket: bölüm adresi + value
+    ABSOLUTE,  // ORG ile yazılmış koddaki etiket: value
+    IMPORT     // XREF: başka bir modülün XDEF ettiği symbol
+};
+
+struct ModuleRelocation {
+    uint32_t section = 0;        // Yamalanacak bölüm
+    uint16_t offset = 0;         // Bölüm içindeki ilk operand byte'ı
+    RelocationKind kind = RelocationKind::ABSOLUTE16;
+    RelocationTarget target = RelocationTarget::ABSOLUTE;
+    uint32_t target_section = 0; // target == SECTION ise
+    uint16_t value = 0;          // Bölüm içi ofset veya mutlak adres
+    std::string symbol;          // Etiket adı (IMPORT'ta çözümlenen ad, diğerlerinde mesajlar için)
+};
+
+// XDEF ile dışa açılan etiket; section < 0 ise value mutlak adrestir
+struct ModuleSymbol {
+    std::string name;
+    int section = -1;
+    uint16_t value = 0;
+};
+
+struct ObjectModule {
+    std::string name;
+    std::vector<ModuleSection> sections;
+    std::vector<ModuleSymbol> exports;
+    std::vector<std::string> imports;
+    std::vector<ModuleRelocation> relocations;
+    uint16_t entry = 0;          // İlk ORG (varsa)
+    bool has_entry = false;
+};
+
+// Hatasız derlenmiş bağlamdan modülü kurar
+void build_module(const AssemblyContext& ctx, const std::string& name, ObjectModule& module);
+
+// Metin biçimi ("M6800OBJ 1" ile başlar, satır satır kayıtlar); okunamazsa false ve error
+bool write_module(std::ostream& out, const ObjectModule& module);
+bool read_module(const char* text, size_t length, ObjectModule& module, std::string& error);
+
+struct LinkOptions {
+    std::vector<std::pair<std::string, uint16_t>> section_bases; // --base=CODE=$1000
+    uint16_t default_base = 0x0100;  // Adresi verilmemiş ilk bölüm buradan başlar
+    std::string entry_symbol;        // Boşsa ilk modülün ENTRY'si, o da yoksa ilk bölüm
+};
+
+// Aynı adlı bölümler modül sırasıyla art arda, farklı adlar ilk görülme sırasıyla yerleştirilir;
+// adresi verilen bölüm oraya konur ve sonrakiler onun arkasından devam eder. Semboller çözülüp
+// yeniden konumlandırmalar uygulanır. Tanımsız veya iki kez XDEF edilmiş semboller, menzil
+// dışı dallanmalar ve çakışan bölümler errors'a eklenir ve false döner.
+bool link_modules(const std::vector<ObjectModule>& modules, const LinkOptions& options,
+                  ObjectImage& image, std::vector<std::string>& errors);
+
+#endif // OBJECT_MODULE_HPP
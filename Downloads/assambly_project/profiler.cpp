@@ -0,0 +1,249 @@
+#include "profiler.hpp"
+#include "text_format.hpp"
+
+namespace {
+
+void append_right(std::string& out, const std::string& text, size_t width) {
+    if (text.size() < width) out.append(width - text.size(), ' ');
+    out += text;
+}
+
+using Label = std::pair<std::string, int>;
+
+// Etiketleri adrese göre sıralar, bellek dışı değerleri (ör. EQU ile tanımlanmış büyük sabitler)
+// atar ve aynı adresteki etiketlerden alfabetik olarak ilkini bırakır
+void prepare_labels(std::vector<Label>& labels) {
+    labels.erase(std::remove_if(labels.begin(), labels.end(), [](const Label& label) {
+        return label.second < 0 || label.second >= static_cast<int>(ExecutionProfile::ADDRESS_COUNT);
+    }), labels.end());
+    std::sort(labels.begin(), labels.end(), [](const Label& a, const Label& b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    });
+    labels.erase(std::unique(labels.begin(), labels.end(), [](const Label& a, const Label& b) {
+        return a.second == b.second;
+    }), labels.end());
+}
+
+// Sıralı etiketlerle adres adı: tam eşleşen etiket, yoksa "ETİKET+$n", o da yoksa "$xxxx"
+std::string address_name(const std::vector<Label>& labels, uint16_t address) {
+    auto after = std::upper_bound(labels.begin(), labels.end(), static_cast<int>(address),
+                                  [](int value, const Label& label) { return value < label.second; });
+    std::string name;
+    if (after == labels.begin()) {
+        name = "$";
+        append_hex(name, address, 4);
+        return name;
+    }
+    const Label& label = *(after - 1);
+    name = label.first;
+    if (label.second != address) {
+        name += "+$";
+        append_hex(name, static_cast<uint32_t>(address - label.second), address - label.second > 0xFF ? 4 : 2);
+    }
+    return name;
+}
+
+} // namespace
+
+void ExecutionProfile::enter(uint16_t target, uint16_t sp) {
+    const uint64_t key = (static_cast<uint64_t>(current) << 16) | target;
+    auto found = children.find(key);
+    uint32_t node;
+    if (found != children.end()) {
+        node = found->second;
+    } else {
+        node = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(CallNode{target, current, 0, 0});
+        children.emplace(key, node);
+    }
+    nodes[node].calls++;
+    frames.push_back(Frame{current, sp});
+    current = node;
+}
+
+void ExecutionProfile::leave(uint16_t sp) {
+    // SP giriş anındakinin üstüne çıktıysa o çerçeve (ve içindekiler) geri dönmüştür
+    while (!frames.empty() && frames.back().sp < sp) {
+        current = frames.back().node;
+        frames.pop_back();
+    }
+}
+
+void ExecutionProfile::clear_call_graph() {
+    nodes.assign(1, CallNode{0, 0, 0, 0});
+    frames.clear();
+    children.clear();
+    current = 0;
+    root_known = false;
+}
+
+std::vector<ProfileHotSpot> fold_profile(const ExecutionProfile& profile, std::vector<Label> labels) {
+    std::vector<ProfileHotSpot> hot_spots;
+    const std::vector<ProfileCounter>& counters = profile.data();
+    if (counters.empty()) return hot_spots;
+    prepare_labels(labels);
+
+    // Aralık sınırları: 0, her etiket, 0x10000. İlk etiketten önceki kod adresiyle adlandırılır.
+    size_t next = 0;
+    uint32_t address = 0;
+    while (address < ExecutionProfile::ADDRESS_COUNT) {
+        ProfileHotSpot spot{};
+        spot.address = static_cast<uint16_t>(address);
+        if (next < labels.size() && static_cast<uint32_t>(labels[next].second) == address) {
+            spot.label = labels[next].first;
+            next++;
+        } else {
+            spot.label = "$";
+            append_hex(spot.label, address, 4);
+        }
+        spot.end = (next < labels.size()) ? static_cast<uint32_t>(labels[next].second)
+                                          : static_cast<uint32_t>(ExecutionProfile::ADDRESS_COUNT);
+        for (uint32_t a = address; a < spot.end; ++a) {
+            spot.hits += counters[a].hits;
+            spot.cycles += counters[a].cycles;
+        }
+        if (spot.hits > 0) hot_spots.push_back(std::move(spot));
+        address = (next < labels.size()) ? static_cast<uint32_t>(labels[next].second)
+                                         : static_cast<uint32_t>(ExecutionProfile::ADDRESS_COUNT);
+    }
+
+    std::stable_sort(hot_spots.begin(), hot_spots.end(), [](const ProfileHotSpot& a, const ProfileHotSpot& b) {
+        return a.cycles > b.cycles;
+    });
+    return hot_spots;
+}
+
+std::string format_profile_report(const std::vector<ProfileHotSpot>& hot_spots, size_t limit) {
+    uint64_t total_cycles = 0, total_hits = 0;
+    for (const ProfileHotSpot& spot : hot_spots) {
+        total_cycles += spot.cycles;
+        total_hits += spot.hits;
+    }
+    const size_t count = (limit > 0) ? std::min(limit, hot_spots.size()) : hot_spots.size();
+
+    std::string out = "LABEL            RANGE             INSTRUCTIONS        CYCLES       %\n";
+    for (size_t i = 0; i < count; ++i) {
+        const ProfileHotSpot& spot = hot_spots[i];
+        out += spot.label;
+        out.append(spot.label.size() < 16 ? 16 - spot.label.size() : 0, ' ');
+        out += " $";
+        append_hex(out, spot.address, 4);
+        out += "-$";
+        append_hex(out, spot.end - 1, 4);
+        append_right(out, std::to_string(spot.hits), 18);
+        append_right(out, std::to_string(spot.cycles), 14);
+        // Binde bir hassasiyetle yüzde (kayan nokta biçimlendirmesine gerek yok)
+        uint64_t permille = total_cycles > 0 ? (spot.cycles * 1000 + total_cycles / 2) / total_cycles : 0;
+        append_right(out, std::to_string(permille / 10) + "." + std::to_string(permille % 10), 8);
+        out.push_back('\n');
+    }
+    if (count < hot_spots.size()) {
+        out += "... " + std::to_string(hot_spots.size() - count) + " more\n";
+    }
+    out += "Total: " + std::to_string(total_hits) + " instructions, " + std::to_string(total_cycles) + " cycles\n";
+    return out;
+}
+
+std::string format_profile_json(const std::vector<ProfileHotSpot>& hot_spots, size_t limit) {
+    const size_t count = (limit > 0) ? std::min(limit, hot_spots.size()) : hot_spots.size();
+    std::string out = "[";
+    for (size_t i = 0; i < count; ++i) {
+        const ProfileHotSpot& spot = hot_spots[i];
+        out += (i == 0) ? "\n" : ",\n";
+        out += "{\"label\":";
+        append_json_string(out, spot.label);
+        out += ",\"address\":" + std::to_string(spot.address) + ",\"end\":" + std::to_string(spot.end)
+             + ",\"hits\":" + std::to_string(spot.hits) + ",\"cycles\":" + std::to_string(spot.cycles) + "}";
+    }
+    out += "\n]\n";
+    return out;
+}
+
+std::vector<CallGraphEntry> fold_call_graph(const ExecutionProfile& profile, std::vector<Label> labels) {
+    std::vector<CallGraphEntry> entries;
+    const std::vector<CallNode>& nodes = profile.call_nodes();
+    if (nodes.empty()) return entries;
+    prepare_labels(labels);
+
+    // Ebeveynler çocuklarından önce geldiği için sondan başa tek geçişle alt ağaç toplamları
+    std::vector<uint64_t> inclusive(nodes.size());
+    for (size_t i = nodes.size(); i-- > 0;) {
+        inclusive[i] += nodes[i].exclusive;
+        if (i > 0) inclusive[nodes[i].parent] += inclusive[i];
+    }
+
+    std::unordered_map<uint16_t, size_t> by_address;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const CallNode& node = nodes[i];
+        auto found = by_address.find(node.address);
+        if (found == by_address.end()) {
+            found = by_address.emplace(node.address, entries.size()).first;
+            entries.push_back(CallGraphEntry{address_name(labels, node.address), node.address, 0, 0, 0});
+        }
+        CallGraphEntry& entry = entries[found->second];
+        entry.calls += node.calls;
+        entry.exclusive += node.exclusive;
+        // Özyinelemeli çağrıda atası aynı alt program olan düğüm zaten atasının toplamında
+        bool nested = false;
+        for (size_t a = i; a > 0 && !nested;) {
+            a = nodes[a].parent;
+            nested = (nodes[a].address == node.address);
+        }
+        if (!nested) entry.inclusive += inclusive[i];
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const CallGraphEntry& a, const CallGraphEntry& b) {
+        return a.inclusive != b.inclusive ? a.inclusive > b.inclusive : a.exclusive > b.exclusive;
+    });
+    return entries;
+}
+
+std::string format_call_graph_report(const std::vector<CallGraphEntry>& entries, size_t limit) {
+    const size_t count = (limit > 0) ? std::min(limit, entries.size()) : entries.size();
+    std::string out = "ROUTINE                ADDR         CALLS     INCLUSIVE     EXCLUSIVE\n";
+    for (size_t i = 0; i < count; ++i) {
+        const CallGraphEntry& entry = entries[i];
+        out += entry.name;
+        out.append(entry.name.size() < 22 ? 22 - entry.name.size() : 0, ' ');
+        out += " $";
+        append_hex(out, entry.address, 4);
+        append_right(out, std::to_string(entry.calls), 14);
+        append_right(out, std::to_string(entry.inclusive), 14);
+        append_right(out, std::to_string(entry.exclusive), 14);
+        out.push_back('\n');
+    }
+    if (count < entries.size()) {
+        out += "... " + std::to_string(entries.size() - count) + " more\n";
+    }
+    return out;
+}
+
+std::string format_call_graph_json(const std::vector<CallGraphEntry>& entries, size_t limit) {
+    const size_t count = (limit > 0) ? std::min(limit, entries.size()) : entries.size();
+    std::string out = "[";
+    for (size_t i = 0; i < count; ++i) {
+        const CallGraphEntry& entry = entries[i];
+        out += (i == 0) ? "\n" : ",\n";
+        out += "{\"name\":";
+        append_json_string(out, entry.name);
+        out += ",\"address\":" + std::to_string(entry.address) + ",\"calls\":" + std::to_string(entry.calls)
+             + ",\"inclusive\":" + std::to_string(entry.inclusive) + ",\"exclusive\":" + std::to_string(entry.exclusive) + "}";
+    }
+    out += "\n]\n";
+    return out;
+}
+
+std::string format_collapsed_stacks(const ExecutionProfile& profile, std::vector<Label> labels) {
+    std::string out;
+    const std::vector<CallNode>& nodes = profile.call_nodes();
+    prepare_labels(labels);
+
+    // Zincir metni ebeveyninkine eklenerek kurulur; çevrimi olmayan zincirler yazılmaz
+    std::vector<std::string> paths(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        std::string name = address_name(labels, nodes[i].address);
+        paths[i] = (i == 0) ? name : paths[nodes[i].parent] + ";" + name;
+        if (nodes[i].exclusive > 0) out += paths[i] + " " + std::to_string(nodes[i].exclusive) + "\n";
+    }
+    return out;
+}
@@ -0,0 +1,148 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Adres başına sayaç: o adresteki opcode kaç kez çalıştı ve toplam kaç çevrim harcadı
+struct ProfileCounter {
+    uint64_t hits;
+    uint64_t cycles;
+};
+
+// Çağrı ağacının bir düğümü: kökten bu düğüme kadar aynı çağrı zinciriyle girilen alt program.
+// Aynı alt program farklı yerlerden çağrılırsa her zincir için ayrı düğüm vardır.
+struct CallNode {
+    uint16_t address;       // Alt programın giriş adresi (kökte ilk çalışan komut)
+    uint32_t parent;        // Kökte kendisi (0)
+    uint64_t calls;         // Bu zincirle kaç kez girildi
+    uint64_t exclusive;     // Doğrudan bu düğümde (alt çağrılar hariç) harcanan çevrim
+};
+
+// Komut profilleyicisinin ham sayaçları. 65536 girdilik düz dizi etkinleştirilirken bir kez
+// ayrılır; sıcak döngüdeki record() sadece iki toplama yapar. Kapalıyken emülatör sayaçsız
+// derlenmiş döngüyü çalıştırır (bkz. Emulator::set_profiling), dolayısıyla maliyeti yoktur.
+//
+// Çağrı grafiği açıksa JSR/BSR (ve vektörlenen SWI) bir gölge çağrı yığınına çerçeve iter,
+// RTS/RTI çerçeveyi çıkarır ve her komutun çevrimi yığının tepesindeki düğüme eklenir. Çerçeve, dönüş adresi
+// itildikten sonraki SP ile tutulur; dönüşte SP'si yeni SP'nin altında kalan bütün çerçeveler
+// çıkarılır. Böylece yığını elle düzenleyen (PULA/PULA ile dönüş adresini atan, TXS ile
+// yığını sıfırlayan) kod zinciri bozmaz.
+class ExecutionProfile {
+public:
+    static constexpr size_t ADDRESS_COUNT = 65536;
+
+    bool enabled() const { return active; }
+    bool call_graph_enabled() const { return call_graph; }
+    void set_enabled(bool enabled, bool track_calls) {
+        active = enabled;
+        call_graph = enabled && track_calls;
+        if (active && counters.empty()) counters.assign(ADDRESS_COUNT, ProfileCounter{0, 0});
+        if (call_graph && nodes.empty()) clear_call_graph();
+    }
+    // Sayaçları ve çağrı ağacını sıfırlar; dizi ayrılmış olarak kalır
+    void clear() {
+        std::fill(counters.begin(), counters.end(), ProfileCounter{0, 0});
+        if (!nodes.empty()) clear_call_graph();
+    }
+
+    // address'teki komut çalıştıktan sonra çağrılır; next_pc ve sp komut sonrası yazmaçlardır
+    void record(uint16_t address, uint8_t opcode, uint64_t cycles, uint16_t next_pc, uint16_t sp) {
+        ProfileCounter& counter = counters[address];
+        counter.hits++;
+        counter.cycles += cycles;
+        if (call_graph) {
+            if (!root_known) {
+                nodes[0].address = address;
+                root_known = true;
+            }
+            nodes[current].exclusive += cycles; // Çağrı komutu çağırana, dönüş komutu çağrılana yazılır
+            switch (opcode) {
+                case OPCODE_BSR: case OPCODE_JSR_IDX: case OPCODE_JSR_EXT: enter(next_pc, sp); break;
+                case OPCODE_SWI:
+                    if (next_pc != static_cast<uint16_t>(address + 1)) enter(next_pc, sp); // Vektörlenen SWI
+                    break;
+                case OPCODE_RTS: case OPCODE_RTI: leave(sp); break;
+                default: break;
+            }
+        }
+    }
+    // Komut dışı bir girişi (ör. kesme) çağrı olarak kaydeder; sp çerçeve itildikten sonraki SP
+    void enter(uint16_t target, uint16_t sp);
+    void leave(uint16_t sp);
+
+    // Hiç etkinleştirilmediyse boş
+    const std::vector<ProfileCounter>& data() const { return counters; }
+    // Düğüm 0 köktür; her düğümün ebeveyni kendisinden önce gelir
+    const std::vector<CallNode>& call_nodes() const { return nodes; }
+
+private:
+    static constexpr uint8_t OPCODE_BSR = 0x8D;
+    static constexpr uint8_t OPCODE_JSR_IDX = 0xAD;
+    static constexpr uint8_t OPCODE_JSR_EXT = 0xBD;
+    static constexpr uint8_t OPCODE_RTS = 0x39;
+    static constexpr uint8_t OPCODE_RTI = 0x3B;
+    static constexpr uint8_t OPCODE_SWI = 0x3F;
+
+    struct Frame {
+        uint32_t node;
+        uint16_t sp;         // Giriş anındaki SP (dönüş adresi itildikten sonra)
+    };
+
+    void clear_call_graph();
+
+    bool active = false;
+    bool call_graph = false;
+    std::vector<ProfileCounter> counters;
+
+    std::vector<CallNode> nodes;
+    std::vector<Frame> frames;                        // Gölge çağrı yığını (kök hariç)
+    std::unordered_map<uint64_t, uint32_t> children;  // (ebeveyn << 16 | adres) -> düğüm
+    uint32_t current = 0;
+    bool root_known = false;
+};
+
+// Etiket düzeyinde özet: [address, end) aralığındaki komutların toplamı
+struct ProfileHotSpot {
+    std::string label;      // Aralığı başlatan etiket; etiketten önceki kod için "$xxxx"
+    uint16_t address;
+    uint32_t end;           // Sonraki etiketin adresi (sonuncuda 0x10000)
+    uint64_t hits;          // Aralıkta çalıştırılan komut sayısı
+    uint64_t cycles;
+};
+
+// Her adresin sayacı, adresine eşit veya ondan küçük en yakın etikete eklenir (aynı adreste
+// birden fazla etiket varsa adı alfabetik olarak ilki kullanılır). Hiç çalışmamış aralıklar
+// atılır; sonuç çevrime göre büyükten küçüğe sıralanır.
+std::vector<ProfileHotSpot> fold_profile(const ExecutionProfile& profile,
+                                         std::vector<std::pair<std::string, int>> labels);
+
+// Sütunlu metin: ETİKET ADRES-ARALIĞI KOMUT ÇEVRİM YÜZDE; limit > 0 ise ilk limit satır
+std::string format_profile_report(const std::vector<ProfileHotSpot>& hot_spots, size_t limit = 0);
+// [{"label":..,"address":..,"end":..,"hits":..,"cycles":..},...]
+std::string format_profile_json(const std::vector<ProfileHotSpot>& hot_spots, size_t limit = 0);
+
+// Alt program başına çağrı grafiği özeti
+struct CallGraphEntry {
+    std::string name;       // Giriş adresindeki etiket; yoksa "ETİKET+$n" veya "$xxxx"
+    uint16_t address;
+    uint64_t calls;
+    uint64_t inclusive;     // Alt çağrılar dahil (özyinelemede iç içe girişler bir kez sayılır)
+    uint64_t exclusive;
+};
+
+// Çağrı ağacını alt programlara göre toplar; inclusive'e göre büyükten küçüğe sıralı
+std::vector<CallGraphEntry> fold_call_graph(const ExecutionProfile& profile,
+                                            std::vector<std::pair<std::string, int>> labels);
+// Sütunlu metin: ALT PROGRAM ÇAĞRI KAPSAYICI ÖZEL; limit > 0 ise ilk limit satır
+std::string format_call_graph_report(const std::vector<CallGraphEntry>& entries, size_t limit = 0);
+std::string format_call_graph_json(const std::vector<CallGraphEntry>& entries, size_t limit = 0);
+// Flame graph araçlarının (flamegraph.pl, speedscope, inferno) okuduğu "collapsed stack" biçimi:
+// her satır "kök;çağıran;çağrılan ÇEVRİM", çevrim o zincirin özel çevrimidir
+std::string format_collapsed_stacks(const ExecutionProfile& profile, std::vector<std::pair<std::string, int>> labels);
+
+#endif // PROFILER_HPP
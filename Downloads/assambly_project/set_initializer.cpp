@@ -1,4 +1,5 @@
 #include "set_initializer.hpp" // Kendi başlık dosyasını include eder (veya doğrudan main.hpp)
+#include "instruction_table.hpp" // gen_instruction_table.py ile üretilen gömülü tablo
 
 #include <sstream>   // istringstream için
 #include <fstream>   // ifstream için
@@ -6,6 +7,7 @@
 #include <vector>    // std::vector (InstructionSet içinde kullanılıyorsa)
 #include <iostream>  // cerr ve cout için
 #include <stdexcept> // std::invalid_argument, std::out_of_range için
+#include <cstdlib>   // std::getenv için
 
 std::string trim_whitespace_local(const std::string& str) { // İsim çakışmasını önlemek için _local ekledim
     const std::string whitespace = " \t\n\r\f\v";
@@ -18,15 +20,37 @@ std::string trim_whitespace_local(const std::string& str) { // İsim çakışmas
 }
 
 
-// set_initializer fonksiyonunun tam tanımı (gövdesi)
+// Gömülü tablo (instruction_table.hpp) derleme zamanında instructions.txt'den üretilir;
+// başlangıçta dosya okunmaz. M6800_INSTRUCTIONS ortam değişkeni bir dosya gösteriyorsa
+// tablo yerine o dosya okunur.
 void set_initializer(InstructionSet &set)
 {
-    std::ifstream file("instructions.txt");
+    const char* override_path = std::getenv(INSTRUCTIONS_OVERRIDE_ENV);
+    if (override_path != nullptr && *override_path != '\0') {
+        if (load_instruction_file(set, override_path)) return;
+        std::cerr << "UYARI: " << INSTRUCTIONS_OVERRIDE_ENV << " ile verilen komut dosyasi okunamadi; gomulu tablo kullaniliyor." << std::endl;
+    }
+
+    for (const InstructionDefinition& def : INSTRUCTION_TABLE) {
+        Instruction instr;
+        instr.instruction = def.mnemonic;
+        instr.opcode = def.opcode;
+        instr.no_of_bytes = def.no_of_bytes;
+        instr.addressing_mode = def.addressing_mode;
+        instr.cycles = def.cycles;
+        set.add_instruction(instr);
+    }
+}
+
+// instructions.txt biçimindeki dosyayı çalışma zamanında okur (gömülü tabloyu değiştirmek için)
+bool load_instruction_file(InstructionSet &set, const std::string &path)
+{
+    std::ifstream file(path);
     std::string line;
 
     if (!file.is_open()) {
-        std::cerr << "HATA: instructions.txt dosyasi acilamadi! Program sonlandiriliyor." << std::endl;
-        return;
+        std::cerr << "HATA: " << path << " dosyasi acilamadi!" << std::endl;
+        return false;
     }
 
     int line_number = 0;
@@ -47,17 +71,19 @@ void set_initializer(InstructionSet &set)
         std::string addressing_mode_str; 
 
         if (!(iss >> instruction_mnemonic >> opcode_str >> num_of_bytes >> addressing_mode_str)) {
-            std::cerr << "UYARI: instructions.txt dosyasinda satir " << line_number << " hatali format: '" << line << "'. Bu satir atlandi." << std::endl;
+            std::cerr << "UYARI: " << path << " dosyasinda satir " << line_number << " hatali format: '" << line << "'. Bu satir atlandi." << std::endl;
             continue; 
         }
+        int cycle_count = 0; // Çevrim sütunu isteğe bağlı
+        iss >> cycle_count;
         
         try {
             opcode_val = std::stoi(opcode_str, nullptr, 16); 
         } catch (const std::invalid_argument& ia) {
-            std::cerr << "UYARI: instructions.txt dosyasinda satir " << line_number << " gecersiz opcode degeri: '" << opcode_str << "'. Bu satir atlandi." << std::endl;
+            std::cerr << "UYARI: " << path << " dosyasinda satir " << line_number << " gecersiz opcode degeri: '" << opcode_str << "'. Bu satir atlandi." << std::endl;
             continue;
         } catch (const std::out_of_range& oor) {
-            std::cerr << "UYARI: instructions.txt dosyasinda satir " << line_number << " opcode degeri aralik disi: '" << opcode_str << "'. Bu satir atlandi." << std::endl;
+            std::cerr << "UYARI: " << path << " dosyasinda satir " << line_number << " opcode degeri aralik disi: '" << opcode_str << "'. Bu satir atlandi." << std::endl;
             continue;
         }
 
@@ -93,7 +119,7 @@ void set_initializer(InstructionSet &set)
         }
         else
         {
-            std::cerr << "UYARI: instructions.txt dosyasinda satir " << line_number
+            std::cerr << "UYARI: " << path << " dosyasinda satir " << line_number
                 << " taninmayan veya desteklenmeyen adresleme modu: '" << addressing_mode_str
                 << "'. NONE olarak ayarlandi." << std::endl;
             mode = AddressingMode::NONE; 
@@ -104,9 +130,11 @@ void set_initializer(InstructionSet &set)
         instr.opcode = opcode_val;
         instr.no_of_bytes = num_of_bytes;
         instr.addressing_mode = mode;
+        instr.cycles = cycle_count;
         
         set.add_instruction(instr); 
     }
 
     file.close();
+    return true;
 }
@@ -5,7 +5,14 @@
                      // ve main.hpp içinde AddressingMode enum'u gibi diğer gerekli
                      // tanımların da olduğunu varsayıyoruz.
 
-// set_initializer fonksiyonunun sadece bildirimi (prototipi)
+#include <string>
+
+// Bu ortam değişkeni bir dosya gösteriyorsa set_initializer gömülü tablo yerine onu okur
+constexpr const char* INSTRUCTIONS_OVERRIDE_ENV = "M6800_INSTRUCTIONS";
+
+// Komut setini derleme zamanında gömülen tablodan kurar (dosya okumaz)
 void set_initializer(InstructionSet &set);
+// instructions.txt biçimindeki dosyayı okur; dosya açılamazsa false döner
+bool load_instruction_file(InstructionSet &set, const std::string &path);
 
 #endif // SET_INITIALIZER_HPP
@@ -0,0 +1,143 @@
+#include "source_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+static constexpr size_t READ_CHUNK = 64 * 1024;
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path, std::string& error) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "dosya acilamadi (Windows hata kodu " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        error = "dosya boyutu okunamadi (Windows hata kodu " + std::to_string(GetLastError()) + ")";
+        CloseHandle(file);
+        return false;
+    }
+    file_handle = file;
+    if (GetFileType(file) != FILE_TYPE_DISK) return read_all(error); // Pipe, konsol: boyutu yoktur
+    size = static_cast<size_t>(file_size.QuadPart);
+    if (size == 0) return true; // Boş dosya eşlenemez; boş metin olarak kabul edilir
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping != nullptr) {
+        mapping_handle = mapping;
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (data == nullptr) {
+        size = 0;
+        return read_all(error); // Eşleme olmazsa dosya okunur
+    }
+    mapped = true;
+    return true;
+}
+
+bool MappedFile::read_all(std::string& error) {
+    char chunk[READ_CHUNK];
+    DWORD count = 0;
+    while (true) {
+        if (!ReadFile(static_cast<HANDLE>(file_handle), chunk, static_cast<DWORD>(sizeof(chunk)), &count, nullptr)) {
+            if (GetLastError() == ERROR_BROKEN_PIPE) break; // Yazan taraf kapandı: dosya sonu
+            error = "dosya okunamadi (Windows hata kodu " + std::to_string(GetLastError()) + ")";
+            close();
+            return false;
+        }
+        if (count == 0) break;
+        buffer.append(chunk, count);
+    }
+    data = buffer.data();
+    size = buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+    if (data != nullptr && mapped) UnmapViewOfFile(data);
+    if (mapping_handle != nullptr) CloseHandle(static_cast<HANDLE>(mapping_handle));
+    if (file_handle != nullptr) CloseHandle(static_cast<HANDLE>(file_handle));
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    buffer.clear();
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path, std::string& error) {
+    close();
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        error = std::strerror(errno);
+        close();
+        return false;
+    }
+    if (!S_ISREG(info.st_mode)) return read_all(error); // Pipe, karakter aygıtı: st_size 0'dır
+    size = static_cast<size_t>(info.st_size);
+    if (size == 0) return true; // Boş dosya eşlenemez; boş metin olarak kabul edilir
+
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        size = 0;
+        return read_all(error); // Eşlemeyi desteklemeyen dosya sistemi: dosya okunur
+    }
+    madvise(view, size, MADV_SEQUENTIAL); // Satırlar baştan sona bir kez okunur
+    data = static_cast<const char*>(view);
+    mapped = true;
+    return true;
+}
+
+bool MappedFile::read_all(std::string& error) {
+    char chunk[READ_CHUNK];
+    while (true) {
+        ssize_t count = ::read(fd, chunk, sizeof(chunk));
+        if (count < 0 && errno == EINTR) continue;
+        if (count < 0) {
+            error = std::strerror(errno);
+            close();
+            return false;
+        }
+        if (count == 0) break;
+        buffer.append(chunk, static_cast<size_t>(count));
+    }
+    data = buffer.data();
+    size = buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+    if (data != nullptr && mapped) munmap(const_cast<char*>(data), size);
+    if (fd >= 0) ::close(fd);
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    buffer.clear();
+    fd = -1;
+}
+
+#endif
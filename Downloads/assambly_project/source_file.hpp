@@ -0,0 +1,42 @@
+#ifndef SOURCE_FILE_HPP
+#define SOURCE_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Kaynak dosyayı salt okunur olarak belleğe eşler (POSIX mmap / Windows MapViewOfFile).
+// Satırlar doğrudan bu görüntü üzerinde string_view olarak işlenir; dosya boyutundan
+// bağımsız olarak satır başına kopya veya bellek ayırma yapılmaz. Eşlenemeyen girdiler
+// (pipe, /dev/stdin, <(komut)) ve eşlemenin başarısız olduğu dosyalar sonuna kadar
+// okunup tek bir tampona alınır.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Dosyayı eşler veya okur; açılamazsa false döner ve hata mesajı error'a yazılır
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    std::string_view text() const { return std::string_view(data, size); }
+
+private:
+    bool read_all(std::string& error); // Açık tanıtıcıyı sonuna kadar buffer'a okur
+
+    const char* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;   // data eşlenmiş görüntü mü, yoksa buffer mı?
+    std::string buffer;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+#endif // SOURCE_FILE_HPP
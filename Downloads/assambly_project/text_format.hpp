@@ -0,0 +1,36 @@
+#ifndef TEXT_FORMAT_HPP
+#define TEXT_FORMAT_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Listeleme, profil raporu, iz ve nesne dosyası yazıcılarının ortak metin yardımcıları.
+// Hepsi ostream formatlaması yerine bir string'e ekler; çıktı locale'den bağımsızdır.
+
+inline constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+
+// value'nun en düşük digits hanesini büyük harfli onaltılık olarak ekler
+inline void append_hex(std::string& out, uint32_t value, int digits) {
+    for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4) out.push_back(HEX_DIGITS[(value >> shift) & 0xF]);
+}
+
+inline void append_hex_byte(std::string& out, uint8_t value) {
+    out.push_back(HEX_DIGITS[value >> 4]);
+    out.push_back(HEX_DIGITS[value & 0x0F]);
+}
+
+// Tırnaklı JSON dizgisi: ", \ ve kontrol karakterleri kaçırılır; diğer byte'lar (UTF-8) aynen yazılır
+inline void append_json_string(std::string& out, std::string_view text) {
+    out.push_back('"');
+    for (char c : text) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') { out.push_back('\\'); out.push_back(c); }
+        else if (c == '\t') out += "\\t";
+        else if (u < 0x20) { out += "\\u00"; append_hex(out, u, 2); }
+        else out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+#endif // TEXT_FORMAT_HPP
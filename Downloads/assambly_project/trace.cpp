@@ -0,0 +1,89 @@
+#include "trace.hpp"
+#include "text_format.hpp"
+#include <iostream>
+
+void StreamTraceSink::on_message(const std::string& text) {
+    std::string line;
+    line.reserve(text.size() + 1);
+    line += text;
+    line.push_back('\n');
+    out.write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+// Satır yerel tamponda biçimlendirilir; akışın flags/fill durumuna dokunulmaz
+void StreamTraceSink::on_instruction(const TraceRecord& record, const char* mnemonic) {
+    std::string line;
+    line.reserve(96);
+    line += "Executing Opcode: $";
+    append_hex_byte(line, record.opcode);
+    line += " (";
+    line += mnemonic;
+    line += ") at PC: $";
+    append_hex(line, record.pc, 4);
+    line += " -> A=$";
+    append_hex_byte(line, record.accA);
+    line += " B=$";
+    append_hex_byte(line, record.accB);
+    line += " X=$";
+    append_hex(line, record.ix, 4);
+    line += " SP=$";
+    append_hex(line, record.sp, 4);
+    line += " CCR=$";
+    append_hex_byte(line, record.ccr);
+    line.push_back('\n');
+    out.write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+void StreamTraceSink::flush() {
+    out.flush();
+}
+
+RingBufferTraceSink::RingBufferTraceSink(size_t capacity) : records(capacity > 0 ? capacity : 1) {}
+
+void RingBufferTraceSink::on_instruction(const TraceRecord& record, const char*) {
+    records[head] = record;
+    head = (head + 1) % records.size();
+    if (count < records.size()) count++;
+}
+
+size_t RingBufferTraceSink::drain(TraceRecord* out_records, size_t max_records) {
+    size_t to_copy = (max_records < count) ? max_records : count;
+    size_t oldest = (head + records.size() - count) % records.size();
+    for (size_t i = 0; i < to_copy; ++i) {
+        out_records[i] = records[(oldest + i) % records.size()];
+    }
+    count -= to_copy;
+    return to_copy;
+}
+
+Tracer::Tracer() : text_sink(nullptr), ring(4096) {
+    set_sink(nullptr);
+}
+
+void Tracer::set_sink(TraceSink* sink) {
+    static StreamTraceSink stdout_sink(std::cout);
+    text_sink = (sink != nullptr) ? sink : &stdout_sink;
+}
+
+void Tracer::message(const std::string& text) {
+    if (current_level != TraceLevel::OFF) {
+        text_sink->on_message(text);
+    }
+}
+
+void Tracer::instruction(const TraceRecord& record, const char* mnemonic) {
+    if (current_level == TraceLevel::BINARY) {
+        ring.on_instruction(record, mnemonic);
+    } else if (current_level == TraceLevel::INSTRUCTION) {
+        text_sink->on_instruction(record, mnemonic);
+    }
+}
+
+void Tracer::flush() {
+    text_sink->flush();
+}
+
+Tracer& default_tracer() {
+    static Tracer tracer;
+    return tracer;
+}
@@ -0,0 +1,104 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+// İz (trace) seviyeleri. OFF dışındaki tüm seviyelerde özet mesajlar yazılır.
+enum class TraceLevel : int {
+    OFF = 0,          // Hiçbir şey yazılmaz
+    SUMMARY = 1,      // Sadece özet mesajlar (program yüklendi, SWI, çalıştırma sonucu...)
+    INSTRUCTION = 2,  // Her komut/satır için metin satırı
+    BINARY = 3        // Her komut için TraceRecord halka tampona yazılır (metin yok)
+};
+
+// Halka tampona yazılan sıkıştırılmış komut kaydı (komut çalıştıktan sonraki durum)
+#pragma pack(push, 1)
+struct TraceRecord {
+    uint16_t pc;      // Komutun opcode adresi
+    uint16_t ix;
+    uint16_t sp;
+    uint8_t opcode;
+    uint8_t accA;
+    uint8_t accB;
+    uint8_t ccr;
+};
+#pragma pack(pop)
+
+// İz çıktısının gideceği yer. Kendi hedefinizi yazmak için bu sınıftan türetin.
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+    virtual void on_message(const std::string& text) = 0;
+    virtual void on_instruction(const TraceRecord& record, const char* mnemonic) = 0;
+    virtual void flush() {}
+};
+
+// Metin çıktısı; her satırı '\n' ile bitirir, her satırda flush yapmaz. Her satır tek bir
+// write ile yazılır ve akışın biçim durumu değiştirilmez; böylece varsayılan std::cout
+// sink'ini paylaşan emülatörler farklı iş parçacıklarında iz tutabilir.
+class StreamTraceSink : public TraceSink {
+public:
+    explicit StreamTraceSink(std::ostream& out) : out(out) {}
+    void on_message(const std::string& text) override;
+    void on_instruction(const TraceRecord& record, const char* mnemonic) override;
+    void flush() override;
+
+private:
+    std::ostream& out;
+};
+
+// Sabit kapasiteli halka tampon; dolunca en eski kayıtların üzerine yazar.
+class RingBufferTraceSink : public TraceSink {
+public:
+    explicit RingBufferTraceSink(size_t capacity);
+    void on_message(const std::string&) override {}
+    void on_instruction(const TraceRecord& record, const char* mnemonic) override;
+
+    // En eskiden yeniye en fazla max_records kaydı kopyalar ve tampondan çıkarır.
+    size_t drain(TraceRecord* out_records, size_t max_records);
+    size_t size() const { return count; }
+
+private:
+    std::vector<TraceRecord> records;
+    size_t head = 0;   // Bir sonraki yazma konumu
+    size_t count = 0;
+};
+
+// Bir iz seviyesi, metin sink'i ve halka tampondan oluşan iz ayarları. Her Emulator
+// kendi Tracer'ına sahiptir. Seviye kontrolü sıcak döngünün dışında yapılmalıdır;
+// emülatör, seviye INSTRUCTION'ın altındayken izsiz derlenmiş döngüyü çalıştırır.
+class Tracer {
+public:
+    Tracer();
+
+    void set_level(TraceLevel new_level) { current_level = new_level; }
+    TraceLevel level() const { return current_level; }
+    bool instructions_enabled() const { return current_level >= TraceLevel::INSTRUCTION; }
+
+    void set_sink(TraceSink* sink);                   // nullptr: std::cout'a yazan varsayılan sink
+    RingBufferTraceSink& ring_buffer() { return ring; } // BINARY seviyesinin kullandığı tampon
+
+    void message(const std::string& text);            // OFF değilse metin sink'ine yazar
+    void instruction(const TraceRecord& record, const char* mnemonic);
+    void flush();
+
+private:
+    TraceLevel current_level = TraceLevel::SUMMARY;
+    TraceSink* text_sink;
+    RingBufferTraceSink ring;
+};
+
+// Tek iş parçacıklı araçlar (assembler) için süreç genelindeki Tracer ve kısayolları
+Tracer& default_tracer();
+
+inline void set_trace_level(TraceLevel level) { default_tracer().set_level(level); }
+inline TraceLevel get_trace_level() { return default_tracer().level(); }
+inline bool trace_instructions_enabled() { return default_tracer().instructions_enabled(); }
+inline void trace_message(const std::string& text) { default_tracer().message(text); }
+inline void trace_flush() { default_tracer().flush(); }
+
+#endif // TRACE_HPP